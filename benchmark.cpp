@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include "interpolator.hpp"
+
+using interp_t = CosineKitty::Interpolator<double, double>;
+
+template <typename func_t>
+double Seconds(func_t func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+void Report(const char *name, std::size_t bytes, std::size_t points, double seconds)
+{
+    printf("%-24s %10.1lf MB/s %12.0lf points/s\n", name, bytes / seconds / 1.0e6, points / seconds);
+}
+
+int main(int argc, const char *argv[])
+{
+    // Measures how fast the point loaders fill an interpolator.
+    const std::size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+
+    std::string text = "x,y\n";
+    char line[64];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double x = 0.001 * i;
+        std::snprintf(line, sizeof(line), "%.17g,%.17g\n", x, std::sin(x));
+        text += line;
+    }
+    printf("%u points, %u bytes of CSV text\n", static_cast<unsigned>(count), static_cast<unsigned>(text.size()));
+
+    interp_t interp;
+    double seconds = Seconds([&]() { CosineKitty::loadCsvPoints(text.data(), text.size(), interp); });
+    Report("CSV from memory", text.size(), interp.size(), seconds);
+
+    interp_t streamed;
+    std::istringstream in(text);
+    seconds = Seconds([&]() { CosineKitty::loadCsvPoints(in, streamed); });
+    Report("CSV from stream", text.size(), streamed.size(), seconds);
+
+    std::stringstream binary;
+    CosineKitty::writeBinary(binary, interp);
+    const std::string bytes = binary.str();
+
+    interp_t decoded;
+    seconds = Seconds([&]() { CosineKitty::loadBinaryPoints(bytes.data(), bytes.size(), decoded); });
+    Report("Binary from memory", bytes.size(), decoded.size(), seconds);
+
+    interp_t read;
+    seconds = Seconds([&]() { CosineKitty::loadBinaryPoints(binary, read); });
+    Report("Binary from stream", bytes.size(), read.size(), seconds);
+
+    return (interp.size() == count && streamed.size() == count && decoded.size() == count && read.size() == count) ? 0 : 1;
+}
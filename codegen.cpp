@@ -0,0 +1,96 @@
+#include <cstdio>
+#include <cmath>
+#include <iostream>
+#include "interpolator.hpp"
+
+// This program is built twice by the `run` script.
+// The first build writes generated code to standard output.
+// The second build, with GENERATED defined, compiles that code
+// and checks that it computes the same values as the library.
+#ifdef GENERATED
+#include "output/generated.hpp"
+#endif
+
+using poly_t = CosineKitty::Polynomial<double, double>;
+using spline_t = CosineKitty::PiecewisePolynomial<float, float>;
+
+poly_t Poly()
+{
+    return poly_t{1.5, -2.0, 0.1, 3.0, 1.0/3.0, -0.25};
+}
+
+spline_t Spline()
+{
+    CosineKitty::Interpolator<float, float> interp;
+    interp.insert(0.0f, 1.0f);
+    interp.insert(0.5f, 3.0f);
+    interp.insert(1.0f, 2.0f);
+    interp.insert(1.5f, 2.5f);
+    interp.insert(2.0f, 0.5f);
+    return interp.naturalSpline();
+}
+
+#ifndef GENERATED
+
+int main()
+{
+    using namespace CosineKitty;
+
+    CodeGenOptions options;
+    options.functionName = "horner";
+    options.batch = true;
+    generateCode(std::cout, Poly(), options);
+
+    options.functionName = "estrin";
+    options.scheme = EvaluationScheme::Estrin;
+    options.useFma = false;
+    options.preamble = false;
+    generateCode(std::cout, Poly(), options);
+
+    options = CodeGenOptions{};
+    options.functionName = "spline";
+    options.preamble = false;
+    generateCode(std::cout, Spline(), options);
+
+    return 0;
+}
+
+#else
+
+bool Compare(const char *name, double x, double expected, double actual, double tolerance)
+{
+    if (std::abs(expected - actual) <= tolerance * (1.0 + std::abs(expected)))
+        return true;
+    printf("FAIL: %s(%lf) = %.17g, expected %.17g\n", name, x, actual, expected);
+    return false;
+}
+
+int main()
+{
+    const poly_t poly = Poly();
+    const spline_t reference = Spline();
+
+    bool ok = true;
+    double xs[41], ys[41];
+    for (int i = 0; i <= 40; ++i)
+    {
+        const double x = -1.0 + 0.0875*i;
+        xs[i] = x;
+        ok = Compare("horner", x, poly(x), horner(x), 1.0e-14) && ok;
+        ok = Compare("estrin", x, poly(x), estrin(x), 1.0e-14) && ok;
+
+        const float u = -0.25f + 0.0625f*i;
+        ok = Compare("spline", u, reference(u), spline(u), 1.0e-6) && ok;
+    }
+
+    horner_batch(xs, ys, 41);
+    for (int i = 0; i <= 40; ++i)
+        ok = Compare("horner_batch", xs[i], poly(xs[i]), ys[i], 1.0e-14) && ok;
+
+    if (!ok)
+        return 1;
+    printf("Generated code output is correct.\n");
+    return 0;
+}
+
+#endif
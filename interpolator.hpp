@@ -29,9 +29,571 @@ SOFTWARE.
 
 #include <vector>
 #include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include <array>
+#include <new>
+#include <limits>
+#include <cmath>
+#include <complex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <locale>
+#include <istream>
+#include <cstring>
+#include <fstream>
+#include <charconv>
+
+// PolynomialBank can map its file into memory on POSIX systems. This is opt-in, because
+// the POSIX headers it needs put names like read, close, and stat in the global namespace.
+// Define COSINEKITTY_ENABLE_MMAP before including this header to enable it.
+#if defined(COSINEKITTY_ENABLE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define COSINEKITTY_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace CosineKitty
 {
+    /// @brief Thrown when an iterative algorithm does not converge within its iteration limit.
+    class ConvergenceError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+
+    /// @brief Options that control how a calculation is divided among multiple threads.
+    struct ParallelOptions
+    {
+        /// @brief The number of threads to use, including the calling thread.
+        /// The default value 0 means to use all available hardware threads.
+        unsigned threadCount = 0;
+
+        /// @brief When `true`, partial results are always combined in the same order,
+        /// so that floating point results are identical from one run to the next,
+        /// regardless of thread scheduling or the number of threads.
+        /// When `false`, work is balanced dynamically among threads,
+        /// and rounding errors may differ slightly between runs.
+        bool deterministic = false;
+
+        /// @brief The number of array elements in each chunk of work handed to a thread.
+        /// The default value 0 means to pick a chunk size whose inputs and outputs
+        /// fit comfortably in a typical per-core cache.
+        std::size_t grainSize = 0;
+
+        /// @brief Returns the number of threads to use, resolving the default value 0.
+        unsigned resolvedThreadCount() const
+        {
+            if (threadCount > 0)
+                return threadCount;
+            const unsigned hardware = std::thread::hardware_concurrency();
+            return (hardware > 0) ? hardware : 1;
+        }
+    };
+
+
+    /// @brief A fixed set of threads that cooperatively process ranges of array indices.
+    /// @remarks
+    /// The pool is created once and reused for any number of calls to #parallelFor.
+    /// Each call divides the index range evenly among the threads, including the calling thread.
+    /// A thread takes grain-sized chunks from the front of its own range. When its range
+    /// is used up, it steals the back half of the remaining range from another thread.
+    /// This keeps every thread busy even when chunks take unequal amounts of time.
+    /// The class also serves as a model for the executor type accepted by
+    /// `Polynomial::evaluate`: any type that has a compatible `parallelFor`
+    /// member function may be used in its place.
+    class WorkStealingPool
+    {
+    private:
+        struct Range
+        {
+            std::mutex mutex;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        std::vector<std::unique_ptr<Range>> ranges;
+        std::vector<std::thread> workers;
+        std::mutex submitMutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        const std::function<void(std::size_t, std::size_t)>* body = nullptr;
+        std::size_t grain = 1;
+        std::uint64_t generation = 0;
+        unsigned busy = 0;
+        bool stopping = false;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+
+        bool take(unsigned self, std::size_t& first, std::size_t& last)
+        {
+            using namespace std;
+
+            Range& own = *ranges[self];
+            {
+                lock_guard<std::mutex> lock(own.mutex);
+                if (own.begin < own.end)
+                {
+                    first = own.begin;
+                    last = min(own.end, own.begin + grain);
+                    own.begin = last;
+                    return true;
+                }
+            }
+
+            // Our own range is empty, so steal the back half of another thread's range.
+            const unsigned n = static_cast<unsigned>(ranges.size());
+            for (unsigned k = 1; k < n; ++k)
+            {
+                Range& victim = *ranges[(self + k) % n];
+                size_t stolenEnd;
+                {
+                    lock_guard<std::mutex> lock(victim.mutex);
+                    const size_t remaining = victim.end - victim.begin;
+                    if (remaining == 0)
+                        continue;
+                    stolenEnd = victim.end;
+                    first = (remaining <= grain) ? victim.begin : (victim.end - remaining/2);
+                    victim.end = first;
+                }
+
+                // Only the owner ever grows a range, so it is safe to refill ours
+                // after releasing the victim's lock. This avoids holding two locks at once.
+                last = min(stolenEnd, first + grain);
+                lock_guard<std::mutex> lock(own.mutex);
+                own.begin = last;
+                own.end = stolenEnd;
+                return true;
+            }
+            return false;
+        }
+
+        void drain(unsigned self)
+        {
+            std::size_t first, last;
+            while (take(self, first, last))
+            {
+                if (failed)
+                    continue;   // keep claiming work so that it is discarded quickly
+
+                try
+                {
+                    (*body)(first, last);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+        }
+
+        void workerLoop(unsigned self)
+        {
+            std::uint64_t seen = 0;
+            for(;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&]{ return stopping || generation != seen; });
+                    if (stopping)
+                        return;
+                    seen = generation;
+                }
+
+                drain(self);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--busy == 0)
+                    idle.notify_one();
+            }
+        }
+
+    public:
+        /// @brief Starts the threads in a new pool.
+        /// @param threadCount
+        /// The number of threads that process work, including the thread that calls #parallelFor.
+        /// The default value 0 means to use all available hardware threads.
+        explicit WorkStealingPool(unsigned threadCount = 0)
+        {
+            ParallelOptions options;
+            options.threadCount = threadCount;
+            const unsigned n = options.resolvedThreadCount();
+            for (unsigned t = 0; t < n; ++t)
+                ranges.emplace_back(new Range);
+
+            try
+            {
+                for (unsigned t = 1; t < n; ++t)
+                    workers.emplace_back(&WorkStealingPool::workerLoop, this, t);
+            }
+            catch (...)
+            {
+                shutdown();
+                throw;
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator= (const WorkStealingPool&) = delete;
+
+        ~WorkStealingPool()
+        {
+            shutdown();
+        }
+
+        /// @brief Returns the number of threads that process work, including the calling thread.
+        unsigned threadCount() const
+        {
+            return static_cast<unsigned>(ranges.size());
+        }
+
+        /// @brief Calls `func(begin, end)` on disjoint chunks that together cover the indices `[0, count)`.
+        /// @remarks
+        /// Returns after every chunk has been processed. If `func` throws an exception,
+        /// the remaining chunks are skipped and the first exception is rethrown to the caller.
+        /// Only one call runs at a time; `func` must not call `parallelFor` on the same pool.
+        /// @param count The number of indices to process.
+        /// @param grainSize The maximum number of indices in each chunk. Zero is treated as 1.
+        /// @param func The function to call on each chunk.
+        void parallelFor(std::size_t count, std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& func)
+        {
+            using namespace std;
+
+            if (count == 0)
+                return;
+
+            lock_guard<std::mutex> submit(submitMutex);
+            const size_t n = ranges.size();
+            for (size_t t = 0; t < n; ++t)
+            {
+                lock_guard<std::mutex> lock(ranges[t]->mutex);
+                ranges[t]->begin = count / n * t + min(t, count % n);
+                ranges[t]->end   = count / n * (t+1) + min(t+1, count % n);
+            }
+
+            {
+                lock_guard<std::mutex> lock(mutex);
+                body = &func;
+                grain = max<size_t>(grainSize, 1);
+                error = nullptr;
+                failed = false;
+                busy = static_cast<unsigned>(workers.size());
+                ++generation;
+            }
+            wake.notify_all();
+
+            drain(0);
+
+            unique_lock<std::mutex> lock(mutex);
+            idle.wait(lock, [&]{ return busy == 0; });
+            body = nullptr;
+            if (error)
+                rethrow_exception(error);
+        }
+
+    private:
+        void shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& w : workers)
+                w.join();
+            workers.clear();
+        }
+    };
+
+
+    namespace Internal
+    {
+        // Calls func(index) for index = 0, 1, ..., count-1, each on its own thread.
+        // Index 0 runs on the calling thread. Waits for all threads to finish,
+        // then rethrows the first exception thrown by any of them.
+        template<typename func_t>
+        void runThreads(unsigned count, func_t& func)
+        {
+            std::exception_ptr error;
+            std::mutex mutex;
+            auto body = [&](unsigned index)
+            {
+                try
+                {
+                    func(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            try
+            {
+                for (unsigned index = 1; index < count; ++index)
+                    workers.emplace_back(body, index);
+            }
+            catch (...)
+            {
+                for (std::thread& w : workers)
+                    w.join();
+                throw;
+            }
+
+            body(0);
+            for (std::thread& w : workers)
+                w.join();
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        // Replaces a list of complex values with its discrete Fourier transform,
+        // using the iterative radix-2 algorithm. The length must be a power of 2.
+        template<typename real_t>
+        void fft(std::vector<std::complex<real_t>>& data)
+        {
+            using namespace std;
+            const size_t n = data.size();
+
+            for (size_t i = 1, j = 0; i < n; ++i)
+            {
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+                j ^= bit;
+                if (i < j)
+                    swap(data[i], data[j]);
+            }
+
+            // The twiddle factors exp(-2*pi*i*k/n) for the full length, computed once.
+            // A stage of length len uses every (n/len)-th entry.
+            const real_t pi = acos(real_t{-1});
+            const real_t angle = -2 * pi / static_cast<real_t>(n);
+            vector<complex<real_t>> twiddle(n/2);
+            for (size_t k = 0; k < n/2; ++k)
+                twiddle[k] = polar(real_t{1}, angle * static_cast<real_t>(k));
+
+            for (size_t len = 2; len <= n; len <<= 1)
+            {
+                const size_t stride = n / len;
+                for (size_t start = 0; start < n; start += len)
+                {
+                    for (size_t k = 0; k < len/2; ++k)
+                    {
+                        const complex<real_t> w = twiddle[k * stride];
+                        const complex<real_t> a = data[start + k];
+                        const complex<real_t> b = w * data[start + k + len/2];
+                        data[start + k] = a + b;
+                        data[start + k + len/2] = a - b;
+                    }
+                }
+            }
+        }
+
+        // Given the coefficients of a polynomial p(s), returns the coefficients
+        // of p(a + b*x), using Horner's method on the coefficient list.
+        template<typename domain_t, typename range_t>
+        std::vector<range_t> substituteLinear(const std::vector<range_t>& c, domain_t a, domain_t b)
+        {
+            const std::size_t n = c.size();
+            std::vector<range_t> result(n);
+            if (n == 0)
+                return result;
+            result[0] = c[n-1];
+            for (std::size_t i = n-1, degree = 0; i > 0; --i, ++degree)
+            {
+                result[degree+1] = b*result[degree];
+                for (std::size_t m = degree; m > 0; --m)
+                    result[m] = a*result[m] + b*result[m-1];
+                result[0] = a*result[0] + c[i-1];
+            }
+            return result;
+        }
+
+        // The complex type whose parts have the same precision as a real or complex type.
+        template<typename value_t>
+        struct ComplexOf
+        {
+            using type = std::complex<value_t>;
+        };
+
+        template<typename real_t>
+        struct ComplexOf<std::complex<real_t>>
+        {
+            using type = std::complex<real_t>;
+        };
+
+        // Returns the monomial coefficients of the Lagrange basis polynomials for the given nodes,
+        // as an n-by-n matrix whose row j holds the basis polynomial that is 1 at xs[j] and 0 at the
+        // other nodes, in increasing order of power. Costs O(n^2): the product of all (x - x_k)
+        // is formed once, and each factor is divided out again by synthetic division.
+        template<typename domain_t>
+        std::vector<domain_t> lagrangeBasis(const std::vector<domain_t>& xs)
+        {
+            const std::size_t n = xs.size();
+            std::vector<domain_t> product(n+1, domain_t{0});
+            product[0] = 1;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                for (std::size_t p = k+1; p > 0; --p)
+                    product[p] = product[p-1] - xs[k]*product[p];
+                product[0] = -xs[k]*product[0];
+            }
+
+            std::vector<domain_t> basis(n*n);
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                domain_t* row = basis.data() + j*n;
+                domain_t carry = product[n];
+                for (std::size_t p = n; p > 0; --p)
+                {
+                    row[p-1] = carry;
+                    carry = product[p-1] + xs[j]*carry;
+                }
+                domain_t denom = 1;
+                for (std::size_t k = 0; k < n; ++k)
+                    if (k != j)
+                        denom *= xs[j] - xs[k];
+                const domain_t scale = domain_t{1} / denom;
+                for (std::size_t p = 0; p < n; ++p)
+                    row[p] *= scale;
+            }
+            return basis;
+        }
+
+        // Solves the m-by-m linear system A*x = b in place by Gaussian elimination
+        // with partial pivoting. A is stored row by row. On return, b holds x.
+        template<typename real_t>
+        void solveLinearSystem(std::vector<real_t>& A, std::vector<real_t>& b)
+        {
+            using namespace std;
+            const size_t m = b.size();
+            for (size_t col = 0; col < m; ++col)
+            {
+                size_t pivot = col;
+                for (size_t row = col+1; row < m; ++row)
+                    if (abs(A[row*m + col]) > abs(A[pivot*m + col]))
+                        pivot = row;
+
+                if (A[pivot*m + col] == real_t{0})
+                    throw runtime_error("Linear system is singular.");
+
+                if (pivot != col)
+                {
+                    for (size_t k = 0; k < m; ++k)
+                        swap(A[col*m + k], A[pivot*m + k]);
+                    swap(b[col], b[pivot]);
+                }
+
+                for (size_t row = col+1; row < m; ++row)
+                {
+                    const real_t factor = A[row*m + col] / A[col*m + col];
+                    for (size_t k = col; k < m; ++k)
+                        A[row*m + k] -= factor * A[col*m + k];
+                    b[row] -= factor * b[col];
+                }
+            }
+
+            for (size_t col = m; col > 0; --col)
+            {
+                const size_t i = col - 1;
+                real_t sum = b[i];
+                for (size_t k = i+1; k < m; ++k)
+                    sum -= A[i*m + k] * b[k];
+                b[i] = sum / A[i*m + i];
+            }
+        }
+
+        // Sums a list of values pairwise, always in the same order,
+        // so that rounding errors grow as log(n) instead of n.
+        template<typename value_t>
+        value_t treeSum(std::vector<value_t>& list)
+        {
+            const std::size_t n = list.size();
+            if (n == 0)
+                return value_t{};
+            for (std::size_t step = 1; step < n; step *= 2)
+                for (std::size_t i = 0; i + step < n; i += 2*step)
+                    list[i] += list[i + step];
+            return list[0];
+        }
+    }
+
+
+    /// @brief A standard-conforming allocator that aligns memory to a cache line boundary.
+    /// @remarks
+    /// Used by containers that store large packed tables of coefficients,
+    /// so that the tables begin on a cache line and suit vector load instructions.
+    /// @tparam value_t The type of element to allocate.
+    /// @tparam alignment The alignment in bytes. Must be a power of 2.
+    template<typename value_t, std::size_t alignment = 64>
+    struct AlignedAllocator
+    {
+        using value_type = value_t;
+
+        template<typename other_t>
+        struct rebind
+        {
+            using other = AlignedAllocator<other_t, alignment>;
+        };
+
+        AlignedAllocator() {}
+
+        template<typename other_t>
+        AlignedAllocator(const AlignedAllocator<other_t, alignment>&) {}
+
+        value_t* allocate(std::size_t n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(value_t))
+                throw std::bad_array_new_length();
+            return static_cast<value_t*>(::operator new(n * sizeof(value_t), std::align_val_t(alignment)));
+        }
+
+        void deallocate(value_t* p, std::size_t)
+        {
+            ::operator delete(p, std::align_val_t(alignment));
+        }
+
+        template<typename other_t>
+        bool operator== (const AlignedAllocator<other_t, alignment>&) const
+        {
+            return true;
+        }
+
+        template<typename other_t>
+        bool operator!= (const AlignedAllocator<other_t, alignment>&) const
+        {
+            return false;
+        }
+    };
+
+
+    template<typename domain_t, typename range_t> class DerivativeView;
+    template<typename domain_t, typename range_t> class IntegralView;
+    template<typename domain_t, typename range_t> class ChebyshevSeries;
+
+
     /// @brief Represents a polynomial `y = f(x)` in terms of an indepdendent variable `x`.
     /// @tparam domain_t
     /// The numeric type of the independent variable `x`.
@@ -63,6 +625,158 @@ namespace CosineKitty
             coeff.resize(i);
         }
 
+        // The number of x values that batch evaluation steps through Horner's method together.
+        static constexpr std::size_t evaluateBlockSize = 256;
+
+        // The number of bytes of input and output in a default-sized chunk of parallel work.
+        static constexpr std::size_t chunkBytes = 64 * 1024;
+
+        static std::size_t defaultGrainSize()
+        {
+            return chunkBytes / (sizeof(domain_t) + sizeof(range_t));
+        }
+
+        // Below this many coefficients, schoolbook multiplication beats Karatsuba.
+        static constexpr std::size_t karatsubaThreshold = 32;
+
+        // Below this quotient/divisor length, schoolbook long division beats Newton iteration.
+        static constexpr std::size_t newtonDivisionThreshold = 128;
+
+        static std::vector<range_t> multiplyFast(const std::vector<range_t>& a, const std::vector<range_t>& b)
+        {
+            // Calculates the full product of two coefficient lists,
+            // using Karatsuba's method when both lists are long.
+            using namespace std;
+
+            const size_t na = a.size();
+            const size_t nb = b.size();
+            if (na == 0 || nb == 0)
+                return vector<range_t>{};
+
+            vector<range_t> prod(na + nb - 1);
+            if (na < karatsubaThreshold || nb < karatsubaThreshold)
+            {
+                for (size_t i = 0; i < na; ++i)
+                    for (size_t j = 0; j < nb; ++j)
+                        prod[i+j] += a[i] * b[j];
+                return prod;
+            }
+
+            if (2*na <= nb || 2*nb <= na)
+            {
+                // Karatsuba works best on operands of similar length.
+                // Cut the longer operand into pieces as long as the shorter one.
+                const vector<range_t>& shortOp = (na < nb) ? a : b;
+                const vector<range_t>& longOp  = (na < nb) ? b : a;
+                const size_t s = shortOp.size();
+                for (size_t start = 0; start < longOp.size(); start += s)
+                {
+                    const size_t stop = min(start + s, longOp.size());
+                    vector<range_t> piece(longOp.begin() + start, longOp.begin() + stop);
+                    vector<range_t> partial = multiplyFast(shortOp, piece);
+                    for (size_t i = 0; i < partial.size(); ++i)
+                        prod[start + i] += partial[i];
+                }
+                return prod;
+            }
+
+            // Split a = a0 + x^h*a1, b = b0 + x^h*b1, then
+            // a*b = z0 + x^h*(z1 - z0 - z2) + x^(2h)*z2,
+            // where z0 = a0*b0, z2 = a1*b1, z1 = (a0 + a1)*(b0 + b1).
+            const size_t h = min(na, nb) / 2;
+            vector<range_t> a0(a.begin(), a.begin() + h);
+            vector<range_t> b0(b.begin(), b.begin() + h);
+            vector<range_t> a1(a.begin() + h, a.end());
+            vector<range_t> b1(b.begin() + h, b.end());
+            vector<range_t> z0 = multiplyFast(a0, b0);
+            vector<range_t> z2 = multiplyFast(a1, b1);
+            for (size_t i = 0; i < h; ++i)
+            {
+                a1[i] += a0[i];
+                b1[i] += b0[i];
+            }
+            vector<range_t> z1 = multiplyFast(a1, b1);
+            for (size_t i = 0; i < z0.size(); ++i)
+            {
+                prod[i] += z0[i];
+                z1[i] -= z0[i];
+            }
+            for (size_t i = 0; i < z2.size(); ++i)
+            {
+                prod[i + 2*h] += z2[i];
+                z1[i] -= z2[i];
+            }
+            for (size_t i = 0; i < z1.size(); ++i)
+                prod[i + h] += z1[i];
+            return prod;
+        }
+
+        static std::vector<range_t> multiplyLow(const std::vector<range_t>& a, const std::vector<range_t>& b, std::size_t k)
+        {
+            // Returns the product of two coefficient lists modulo x^k.
+            using namespace std;
+            vector<range_t> at(a.begin(), a.begin() + min(k, a.size()));
+            vector<range_t> bt(b.begin(), b.begin() + min(k, b.size()));
+            vector<range_t> prod = multiplyFast(at, bt);
+            prod.resize(k);
+            return prod;
+        }
+
+        void divideSchoolbook(const Polynomial& divisor, std::vector<range_t>& quot, std::vector<range_t>& rem) const
+        {
+            using namespace std;
+            const size_t a = coeff.size();
+            const size_t b = divisor.coeff.size();
+            const range_t lead = divisor.coeff[b-1];
+            rem = coeff;
+            quot.resize(a - b + 1);
+            for (size_t k = a - b + 1; k > 0; --k)
+            {
+                // Eliminate the term x^(k+b-2) using the quotient term x^(k-1).
+                const range_t q = rem[k+b-2] / lead;
+                quot[k-1] = q;
+                for (size_t j = 0; j < b; ++j)
+                    rem[k-1+j] -= q * divisor.coeff[j];
+            }
+            rem.resize(b - 1);
+        }
+
+        void divideNewton(const Polynomial& divisor, std::vector<range_t>& quot, std::vector<range_t>& rem) const
+        {
+            // If the dividend has degree n and the divisor has degree d, reversing the coefficients
+            // gives rev(a) = rev(q)*rev(b) mod x^(n-d+1). Because rev(b) has a nonzero
+            // constant term, it has a power series inverse that we find by Newton's
+            // iteration g <- g*(2 - rev(b)*g), doubling the number of correct terms each time.
+            using namespace std;
+            const size_t a = coeff.size();
+            const size_t b = divisor.coeff.size();
+            const size_t m = a - b + 1;
+
+            const vector<range_t> revA(coeff.rbegin(), coeff.rend());
+            const vector<range_t> revB(divisor.coeff.rbegin(), divisor.coeff.rend());
+
+            const range_t one = 1;
+            const range_t two = 2;
+            vector<range_t> inv { one / revB[0] };
+            for (size_t k = 1; k < m; )
+            {
+                k = min(2*k, m);
+                vector<range_t> err = multiplyLow(revB, inv, k);
+                for (range_t& e : err)
+                    e = -e;
+                err[0] += two;
+                inv = multiplyLow(inv, err, k);
+            }
+
+            vector<range_t> revQ = multiplyLow(revA, inv, m);
+            quot.assign(revQ.rbegin(), revQ.rend());
+
+            // The remainder has fewer terms than the divisor, so only the low-order terms are needed.
+            rem = multiplyLow(quot, divisor.coeff, b - 1);
+            for (size_t i = 0; i < b - 1; ++i)
+                rem[i] = coeff[i] - rem[i];
+        }
+
     public:
         /// @brief Creates a polynomial that represents the function f(x) = 0.
         Polynomial() {}
@@ -103,16 +817,144 @@ namespace CosineKitty
             return sum;
         }
 
-        /// @brief Indicates whether the polynomial is the constant function f(x) = 0.
-        /// @return `true` if this polynomial is equivalent to zero, otherwise `false`.
-        bool isZero() const
+        /// @brief Evaluates the polynomial and its first `order` derivatives at a given value of x.
+        /// @remarks
+        /// All values are found in a single pass of an extended Horner's method,
+        /// without creating any derivative polynomials or allocating memory.
+        /// @param x The value of the independent variable.
+        /// @param results
+        /// An array of `order+1` elements that receives f(x), f'(x), f''(x), ..., in that order.
+        /// Derivatives of higher order than the degree of the polynomial are zero.
+        /// @param order The highest derivative to evaluate.
+        void evaluateWithDerivatives(domain_t x, range_t* results, std::size_t order) const
         {
-            return coeff.empty();
-        }
+            using namespace std;
+            const size_t n = coeff.size();
+            for (size_t j = 0; j <= order; ++j)
+                results[j] = 0;
 
-        /// @brief Allows read-only access to the coefficients inside this polynomial.
-        /// @return A reference to a vector of coefficients inside this polynomial.
-        const std::vector<range_t>& coefficients() const
+            if (n == 0)
+                return;
+
+            // After the loop, results[j] holds the jth derivative divided by j!.
+            results[0] = coeff[n-1];
+            for (size_t i = n-1; i > 0; --i)
+            {
+                for (size_t j = min(order, n-i); j > 0; --j)
+                    results[j] = x*results[j] + results[j-1];
+                results[0] = x*results[0] + coeff[i-1];
+            }
+
+            domain_t factorial = 1;
+            for (size_t j = 2; j <= order; ++j)
+            {
+                factorial *= static_cast<domain_t>(j);
+                results[j] = factorial * results[j];
+            }
+        }
+
+        /// @brief Evaluates the polynomial and its first `order` derivatives at a given value of x.
+        /// @tparam order The highest derivative to evaluate.
+        /// @param x The value of the independent variable.
+        /// @return An array holding f(x), f'(x), f''(x), ..., in that order.
+        template<std::size_t order>
+        std::array<range_t, order+1> evaluateWithDerivatives(domain_t x) const
+        {
+            std::array<range_t, order+1> results;
+            evaluateWithDerivatives(x, results.data(), order);
+            return results;
+        }
+
+        /// @brief Evaluates the polynomial and its first `order` derivatives for an array of x values.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param results
+        /// An array of `count*(order+1)` elements. For each x value, in turn,
+        /// receives f(x), f'(x), f''(x), ..., in that order.
+        /// @param count The number of values to evaluate.
+        /// @param order The highest derivative to evaluate.
+        void evaluateWithDerivatives(const domain_t* x, range_t* results, std::size_t count, std::size_t order) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                evaluateWithDerivatives(x[i], results + i*(order+1), order);
+        }
+
+        /// @brief Evaluates the polynomial for an array of x values.
+        /// @remarks
+        /// The values are processed in small blocks, stepping all values in a block
+        /// through each Horner iteration together. This lets the compiler
+        /// vectorize the inner loop across independent x values.
+        /// The input and output arrays must not overlap.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the values f(x).
+        /// @param count The number of values to evaluate.
+        void evaluate(const domain_t* x, range_t* y, std::size_t count) const
+        {
+            using namespace std;
+            const size_t n = coeff.size();
+            for (size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const size_t stop = min(count, start + evaluateBlockSize);
+                const range_t top = (n > 0) ? coeff[n-1] : range_t{0};
+                for (size_t i = start; i < stop; ++i)
+                    y[i] = top;
+                for (size_t k = n; k > 1; --k)
+                {
+                    const range_t c = coeff[k-2];
+                    for (size_t i = start; i < stop; ++i)
+                        y[i] = x[i]*y[i] + c;
+                }
+            }
+        }
+
+        /// @brief Evaluates the polynomial for an array of x values using an executor's threads.
+        /// @remarks
+        /// The array is cut into chunks of `grainSize` elements, and each chunk is
+        /// evaluated by the serial batch #evaluate on whatever thread the executor picks.
+        /// The executor may be a #WorkStealingPool or any other type with a member function
+        /// `parallelFor(count, grainSize, func)` that calls `func(begin, end)` on
+        /// disjoint chunks covering `[0, count)` and returns when they are all finished.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the values f(x).
+        /// @param count The number of values to evaluate.
+        /// @param executor The object that schedules chunks onto threads.
+        /// @param grainSize The number of elements per chunk, or 0 to pick a cache-sized default.
+        template<typename executor_t, typename = typename std::enable_if<!std::is_same<typename std::decay<executor_t>::type, ParallelOptions>::value>::type>
+        void evaluate(const domain_t* x, range_t* y, std::size_t count, executor_t& executor, std::size_t grainSize = 0) const
+        {
+            if (grainSize == 0)
+                grainSize = defaultGrainSize();
+
+            executor.parallelFor(count, grainSize, [this, x, y](std::size_t begin, std::size_t end)
+            {
+                evaluate(x + begin, y + begin, end - begin);
+            });
+        }
+
+        /// @brief Evaluates the polynomial for an array of x values using a temporary thread pool.
+        /// @remarks
+        /// Every call starts a new #WorkStealingPool and joins its threads before returning,
+        /// so each call pays the cost of creating threads. For repeated calls, create one
+        /// `WorkStealingPool` and pass it to the executor overload of #evaluate instead.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the values f(x).
+        /// @param count The number of values to evaluate.
+        /// @param options Specifies the number of threads and the chunk size.
+        void evaluate(const domain_t* x, range_t* y, std::size_t count, const ParallelOptions& options) const
+        {
+            WorkStealingPool pool(options.threadCount);
+            evaluate(x, y, count, pool, options.grainSize);
+        }
+
+        /// @brief Indicates whether the polynomial is the constant function f(x) = 0.
+        /// @return `true` if this polynomial is equivalent to zero, otherwise `false`.
+        bool isZero() const
+        {
+            return coeff.empty();
+        }
+
+        /// @brief Allows read-only access to the coefficients inside this polynomial.
+        /// @return A reference to a vector of coefficients inside this polynomial.
+        const std::vector<range_t>& coefficients() const
         {
             return coeff;
         }
@@ -241,6 +1083,73 @@ namespace CosineKitty
             return *this;
         }
 
+        /// @brief Divides this polynomial by another, finding both quotient and remainder.
+        /// @remarks
+        /// The results satisfy `*this == quotient*divisor + remainder`,
+        /// where the remainder has a lower degree than the divisor.
+        /// Small problems are solved by schoolbook long division.
+        /// When both the quotient and the divisor have many terms, the quotient is
+        /// found instead by Newton iteration on the reversed divisor, which costs a
+        /// few Karatsuba multiplications instead of a quadratic number of operations.
+        /// This function throws `std::domain_error` if `divisor` is zero.
+        /// @param divisor The polynomial to divide this polynomial by.
+        /// @return A pair whose `first` is the quotient and whose `second` is the remainder.
+        std::pair<Polynomial, Polynomial> divmod(const Polynomial& divisor) const
+        {
+            using namespace std;
+
+            if (divisor.isZero())
+                throw domain_error("Cannot divide a Polynomial by zero.");
+
+            const size_t a = coeff.size();
+            const size_t b = divisor.coeff.size();
+            if (a < b)
+                return make_pair(Polynomial{}, *this);
+
+            vector<range_t> quot;
+            vector<range_t> rem;
+            if (min(a - b + 1, b) < newtonDivisionThreshold)
+                divideSchoolbook(divisor, quot, rem);
+            else
+                divideNewton(divisor, quot, rem);
+
+            return make_pair(Polynomial{quot}, Polynomial{rem});
+        }
+
+        /// @brief Divides two polynomials, discarding any remainder.
+        /// @param divisor The polynomial to divide this polynomial by.
+        /// @return A new polynomial equal to the quotient. See #divmod.
+        Polynomial operator/ (const Polynomial& divisor) const
+        {
+            return divmod(divisor).first;
+        }
+
+        /// @brief Updates this polynomial by dividing it by another polynomial.
+        /// @param divisor The polynomial to divide this polynomial by.
+        /// @return A reference to this polynomial, which has been replaced by the quotient.
+        Polynomial& operator /= (const Polynomial& divisor)
+        {
+            *this = *this / divisor;
+            return *this;
+        }
+
+        /// @brief Finds the remainder after dividing two polynomials.
+        /// @param divisor The polynomial to divide this polynomial by.
+        /// @return A new polynomial equal to the remainder. See #divmod.
+        Polynomial operator% (const Polynomial& divisor) const
+        {
+            return divmod(divisor).second;
+        }
+
+        /// @brief Updates this polynomial by reducing it modulo another polynomial.
+        /// @param divisor The polynomial to divide this polynomial by.
+        /// @return A reference to this polynomial, which has been replaced by the remainder.
+        Polynomial& operator %= (const Polynomial& divisor)
+        {
+            *this = *this % divisor;
+            return *this;
+        }
+
         /// @brief Raises this polynomial to a non-negative integer power.
         /// @param exponent
         /// A non-negative integer power.
@@ -294,6 +1203,8 @@ namespace CosineKitty
             using namespace std;
             vector<range_t> deriv;
             const size_t n = coeff.size();
+            if (n > 1)
+                deriv.reserve(n - 1);
             for (size_t i = 1; i < n; ++i)
                 deriv.push_back(static_cast<domain_t>(i) * coeff[i]);
             return Polynomial{deriv};
@@ -306,13 +1217,422 @@ namespace CosineKitty
         Polynomial integral(range_t arbitraryConstant = 0) const
         {
             using namespace std;
+            const size_t n = coeff.size();
             vector<range_t> poly;
+            poly.reserve(n + 1);
             poly.push_back(arbitraryConstant);
-            const size_t n = coeff.size();
             for (size_t i = 0; i < n; ++i)
                 poly.push_back(coeff[i] / static_cast<domain_t>(i+1));
             return poly;
         }
+
+        /// @brief Evaluates the definite integral of this polynomial from `a` to `b`.
+        /// @remarks
+        /// Evaluates the antiderivative at both limits in a single pass of Horner's method,
+        /// directly from the coefficients, without creating the integral polynomial.
+        /// @param a The lower limit of integration.
+        /// @param b The upper limit of integration.
+        /// @return The integral of f(x) dx from x=a to x=b.
+        range_t definiteIntegral(domain_t a, domain_t b) const
+        {
+            // F(x) = x*(c0 + x*(c1/2 + x*(c2/3 + ...))), so F(b) - F(a) needs
+            // only one division per coefficient, shared by both limits.
+            std::size_t i = coeff.size();
+            if (i == 0)
+                return 0;
+            range_t term = coeff[i-1] / static_cast<domain_t>(i);
+            range_t fa = term;
+            range_t fb = term;
+            while (--i > 0)
+            {
+                term = coeff[i-1] / static_cast<domain_t>(i);
+                fa = a*fa + term;
+                fb = b*fb + term;
+            }
+            return b*fb - a*fa;
+        }
+
+        /// @brief Evaluates the definite integral of this polynomial over an array of intervals.
+        /// @remarks
+        /// The intervals are processed in blocks, so that each coefficient is divided
+        /// by its power only once per block, and the inner loop vectorizes across intervals.
+        /// Does not allocate memory.
+        /// @param a An array of `count` lower limits of integration.
+        /// @param b An array of `count` upper limits of integration.
+        /// @param results An array of `count` elements that receives the integral over each interval.
+        /// @param count The number of intervals.
+        void definiteIntegral(const domain_t* a, const domain_t* b, range_t* results, std::size_t count) const
+        {
+            using namespace std;
+            const size_t n = coeff.size();
+            range_t fa[evaluateBlockSize];
+            range_t fb[evaluateBlockSize];
+            for (size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const size_t len = min(evaluateBlockSize, count - start);
+                const domain_t* ablock = a + start;
+                const domain_t* bblock = b + start;
+                if (n == 0)
+                {
+                    for (size_t k = 0; k < len; ++k)
+                        results[start + k] = 0;
+                    continue;
+                }
+
+                const range_t top = coeff[n-1] / static_cast<domain_t>(n);
+                for (size_t k = 0; k < len; ++k)
+                    fa[k] = fb[k] = top;
+
+                for (size_t i = n-1; i > 0; --i)
+                {
+                    const range_t term = coeff[i-1] / static_cast<domain_t>(i);
+                    for (size_t k = 0; k < len; ++k)
+                    {
+                        fa[k] = ablock[k]*fa[k] + term;
+                        fb[k] = bblock[k]*fb[k] + term;
+                    }
+                }
+
+                for (size_t k = 0; k < len; ++k)
+                    results[start + k] = bblock[k]*fb[k] - ablock[k]*fa[k];
+            }
+        }
+
+        /// @brief Finds a lower-degree polynomial that stays within a tolerance of this one over an interval.
+        /// @remarks
+        /// This is Chebyshev economization. The polynomial is converted to a Chebyshev series
+        /// over `[a, b]`. Because every Chebyshev polynomial stays within [-1, +1] on the interval,
+        /// dropping high-order terms changes the value by no more than the sum of their coefficient
+        /// magnitudes. As many terms are dropped as the tolerance allows, and the remaining series
+        /// is converted back to a polynomial. The result is the lowest-degree truncation of the
+        /// Chebyshev series that meets the bound, apart from rounding errors.
+        /// Requires a real-like `domain_t`.
+        /// @param tolerance The largest allowed difference between the result and this polynomial over `[a, b]`.
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        /// @return A polynomial of equal or lower degree that is within `tolerance` of this one over the interval.
+        Polynomial reduceDegree(double tolerance, domain_t a, domain_t b) const
+        {
+            using namespace std;
+            const ChebyshevSeries<domain_t, range_t> series = ChebyshevSeries<domain_t, range_t>::fromPolynomial(*this, a, b);
+            vector<range_t> c = series.coefficients();
+            double dropped = 0;
+            size_t keep = c.size();
+            while (keep > 0)
+            {
+                const double size = static_cast<double>(abs(c[keep-1]));
+                if (dropped + size > tolerance)
+                    break;
+                dropped += size;
+                --keep;
+            }
+            c.resize(keep);
+            return ChebyshevSeries<domain_t, range_t>{c, a, b}.toPolynomial();
+        }
+
+        /// @brief Finds all roots of the polynomial, real and complex, by Aberth-Ehrlich iteration.
+        /// @remarks
+        /// Returns one complex value for each root, repeated according to multiplicity,
+        /// so the number of roots equals the degree. They are sorted by real part, then imaginary part.
+        /// Roots of polynomials with real coefficients are returned as complex values
+        /// whose imaginary parts are zero or nearly zero for real roots.
+        /// The Aberth-Ehrlich method refines approximations to every root at once.
+        /// Each step updates all roots independently from the previous approximations,
+        /// using split real arithmetic for the repulsion sum between roots.
+        /// An approximation stops moving when its correction is at the rounding level of its value,
+        /// or when the polynomial's value there is at the rounding level of the evaluation.
+        /// Multiple roots converge more slowly and less accurately than simple roots.
+        /// Throws `std::domain_error` for the zero polynomial, which has no finite set of roots.
+        /// Throws `std::runtime_error` if any root has not converged after `maxIterations` steps.
+        /// Requires `range_t` to be a floating point type or `std::complex` of one.
+        /// @param maxIterations The maximum number of refinement steps.
+        /// @return The roots of the polynomial.
+        std::vector<typename Internal::ComplexOf<range_t>::type> roots(int maxIterations = 500) const
+        {
+            using namespace std;
+            using complex_t = typename Internal::ComplexOf<range_t>::type;
+            using real_t = typename complex_t::value_type;
+
+            if (coeff.empty())
+                throw domain_error("The zero polynomial does not have a finite set of roots.");
+
+            // Factor out roots at zero, then make the remaining polynomial monic.
+            size_t zeros = 0;
+            while (coeff[zeros] == range_t{0})
+                ++zeros;
+            const size_t n = coeff.size() - 1 - zeros;
+            vector<complex_t> result(zeros, complex_t{0});
+            if (n > 0)
+            {
+                // Keep the coefficients as split real and imaginary parts, plus their magnitudes,
+                // so the evaluation below runs in plain real arithmetic.
+                const complex_t lead{coeff.back()};
+                vector<real_t> aRe(n+1), aIm(n+1), amag(n+1);
+                for (size_t k = 0; k <= n; ++k)
+                {
+                    const complex_t a = complex_t{coeff[k + zeros]} / lead;
+                    aRe[k] = a.real();
+                    aIm[k] = a.imag();
+                    amag[k] = abs(a);
+                }
+
+                // Start on a circle whose radius is the geometric mean of the root magnitudes.
+                const real_t radius = std::pow(amag[0], real_t{1} / static_cast<real_t>(n));
+                const real_t pi = acos(real_t{-1});
+                vector<real_t> zr(n), zi(n);
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const real_t angle = 2*pi*static_cast<real_t>(k)/static_cast<real_t>(n) + real_t{0.4};
+                    zr[k] = radius * cos(angle);
+                    zi[k] = radius * sin(angle);
+                }
+
+                const real_t epsilon = numeric_limits<real_t>::epsilon();
+                vector<complex_t> offset(n);
+                vector<bool> done(n, false);
+                for (int iter = 0; iter < maxIterations; ++iter)
+                {
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        offset[k] = complex_t{0};
+                        if (done[k])
+                            continue;
+
+                        // Newton correction p/p' at this root, along with a bound on
+                        // the rounding error of evaluating p there. Horner's rule runs in
+                        // split real arithmetic, as with ComplexMultiply::Fast, rather than
+                        // through std::complex products and their NaN and infinity checks.
+                        const real_t xRe = zr[k];
+                        const real_t xIm = zi[k];
+                        const real_t size = abs(complex_t{xRe, xIm});
+                        real_t pRe = aRe[n];
+                        real_t pIm = aIm[n];
+                        real_t dpRe = 0;
+                        real_t dpIm = 0;
+                        real_t bound = amag[n];
+                        for (size_t m = n; m > 0; --m)
+                        {
+                            const real_t tRe = xRe*dpRe - xIm*dpIm + pRe;
+                            dpIm = xRe*dpIm + xIm*dpRe + pIm;
+                            dpRe = tRe;
+                            const real_t uRe = xRe*pRe - xIm*pIm + aRe[m-1];
+                            pIm = xRe*pIm + xIm*pRe + aIm[m-1];
+                            pRe = uRe;
+                            bound = bound*size + amag[m-1];
+                        }
+                        const complex_t p{pRe, pIm};
+                        const complex_t dp{dpRe, dpIm};
+                        if (abs(p) <= 4 * epsilon * bound)
+                            continue;   // p(z) is indistinguishable from zero
+                        if (dp == complex_t{0})
+                        {
+                            // A critical point of p: nudge z off it and try again next step.
+                            const real_t nudge = sqrt(epsilon) * (1 + size);
+                            offset[k] = complex_t{-nudge, nudge};
+                            continue;
+                        }
+                        const complex_t w = p / dp;
+
+                        // Repulsion from the other roots: the sum of 1/(z_k - z_j).
+                        real_t sr = 0;
+                        real_t si = 0;
+                        for (size_t j = 0; j < n; ++j)
+                        {
+                            const real_t dr = zr[k] - zr[j];
+                            const real_t di = zi[k] - zi[j];
+                            const real_t norm = dr*dr + di*di;
+                            const real_t scale = (j == k || norm == 0) ? real_t{0} : real_t{1} / norm;
+                            sr += dr*scale;
+                            si -= di*scale;
+                        }
+                        const complex_t denom{1 - (w.real()*sr - w.imag()*si), -(w.real()*si + w.imag()*sr)};
+                        offset[k] = w / denom;
+                    }
+
+                    bool active = false;
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        if (done[k])
+                            continue;
+                        zr[k] -= offset[k].real();
+                        zi[k] -= offset[k].imag();
+                        if (abs(offset[k]) <= 4 * epsilon * abs(complex_t{zr[k], zi[k]}) || offset[k] == complex_t{0})
+                            done[k] = true;
+                        else
+                            active = true;
+                    }
+                    if (!active)
+                        break;
+                }
+
+                for (size_t k = 0; k < n; ++k)
+                    if (!done[k])
+                        throw runtime_error("Polynomial roots did not converge within the maximum number of iterations.");
+
+                for (size_t k = 0; k < n; ++k)
+                    result.push_back(complex_t{zr[k], zi[k]});
+            }
+
+            sort(result.begin(), result.end(), [](const complex_t& u, const complex_t& v)
+            {
+                return (u.real() < v.real()) || (u.real() == v.real() && u.imag() < v.imag());
+            });
+            return result;
+        }
+
+        /// @brief Creates a lightweight view that evaluates a derivative of this polynomial.
+        /// @remarks
+        /// Unlike #derivative, this does not create a new polynomial.
+        /// The view refers to this polynomial, which must outlive the view.
+        /// @param order How many times to differentiate. The default is the first derivative.
+        /// @return A view that evaluates the derivative of the specified order.
+        DerivativeView<domain_t, range_t> derivativeView(std::size_t order = 1) const
+        {
+            return DerivativeView<domain_t, range_t>{*this, order};
+        }
+
+        /// @brief Creates a lightweight view that evaluates the indefinite integral of this polynomial.
+        /// @remarks
+        /// Unlike #integral, this does not create a new polynomial.
+        /// The view refers to this polynomial, which must outlive the view.
+        /// @param arbitraryConstant
+        /// The value of the arbitrary constant term to be included in the integral.
+        /// @return A view that evaluates the integral.
+        IntegralView<domain_t, range_t> integralView(range_t arbitraryConstant = 0) const
+        {
+            return IntegralView<domain_t, range_t>{*this, arbitraryConstant};
+        }
+    };
+
+
+    /// @brief A non-owning view that evaluates a derivative of a polynomial without creating a new polynomial.
+    /// @remarks
+    /// Evaluates the derivative directly from the coefficients of the parent polynomial,
+    /// folding the scaling factor for each power of x into Horner's method.
+    /// The parent polynomial must outlive the view. If the parent is modified,
+    /// the view evaluates the derivative of the modified polynomial.
+    /// @tparam domain_t The type of the polynomial's independent variable `x`.
+    /// @tparam range_t The type of the polynomial itself: `y = f(x)`.
+    template<typename domain_t, typename range_t>
+    class DerivativeView
+    {
+    private:
+        const Polynomial<domain_t, range_t>* parent;
+        std::size_t order;
+
+        domain_t scale(std::size_t i) const
+        {
+            // Differentiating x^i `order` times produces the factor i*(i-1)*...*(i-order+1).
+            domain_t factor = 1;
+            for (std::size_t j = 0; j < order; ++j)
+                factor *= static_cast<domain_t>(i - j);
+            return factor;
+        }
+
+    public:
+        /// @brief Creates a view of a derivative of a polynomial.
+        /// @param poly The polynomial to differentiate.
+        /// @param derivativeOrder How many times to differentiate. The default is the first derivative.
+        DerivativeView(const Polynomial<domain_t, range_t>& poly, std::size_t derivativeOrder = 1)
+            : parent(&poly)
+            , order(derivativeOrder)
+            {}
+
+        /// @brief Returns how many times this view differentiates its polynomial.
+        std::size_t derivativeOrder() const
+        {
+            return order;
+        }
+
+        /// @brief Evaluates the derivative for a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The value of the derivative at x.
+        range_t operator() (domain_t x) const
+        {
+            const std::vector<range_t>& coeff = parent->coefficients();
+            std::size_t i = coeff.size();
+            if (i <= order)
+                return 0;
+            --i;
+            // Update the falling factorial i*(i-1)*...*(i-order+1) as i decreases,
+            // instead of recomputing it for every coefficient.
+            domain_t factor = scale(i);
+            range_t sum = factor * coeff[i];
+            while (i > order)
+            {
+                factor = factor * static_cast<domain_t>(i - order) / static_cast<domain_t>(i);
+                --i;
+                sum = x*sum + factor * coeff[i];
+            }
+            return sum;
+        }
+
+        /// @brief Creates a polynomial equal to the derivative represented by this view.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            const std::vector<range_t>& coeff = parent->coefficients();
+            std::vector<range_t> deriv;
+            if (coeff.size() > order)
+            {
+                deriv.reserve(coeff.size() - order);
+                domain_t factor = scale(order);
+                for (std::size_t i = order; i < coeff.size(); ++i)
+                {
+                    if (i > order)
+                        factor = factor * static_cast<domain_t>(i) / static_cast<domain_t>(i - order);
+                    deriv.push_back(factor * coeff[i]);
+                }
+            }
+            return Polynomial<domain_t, range_t>{deriv};
+        }
+    };
+
+
+    /// @brief A non-owning view that evaluates the integral of a polynomial without creating a new polynomial.
+    /// @remarks
+    /// Evaluates the integral directly from the coefficients of the parent polynomial,
+    /// folding the division by each power of x into Horner's method.
+    /// The parent polynomial must outlive the view. If the parent is modified,
+    /// the view evaluates the integral of the modified polynomial.
+    /// @tparam domain_t The type of the polynomial's independent variable `x`.
+    /// @tparam range_t The type of the polynomial itself: `y = f(x)`.
+    template<typename domain_t, typename range_t>
+    class IntegralView
+    {
+    private:
+        const Polynomial<domain_t, range_t>* parent;
+        range_t constant;
+
+    public:
+        /// @brief Creates a view of the indefinite integral of a polynomial.
+        /// @param poly The polynomial to integrate.
+        /// @param arbitraryConstant The value of the arbitrary constant term to be included in the integral.
+        IntegralView(const Polynomial<domain_t, range_t>& poly, range_t arbitraryConstant = 0)
+            : parent(&poly)
+            , constant(arbitraryConstant)
+            {}
+
+        /// @brief Evaluates the integral for a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The value of the integral at x.
+        range_t operator() (domain_t x) const
+        {
+            // C + c0*x + c1*x^2/2 + c2*x^3/3 + ... = C + x*(c0 + x*(c1/2 + x*(c2/3 + ...)))
+            const std::vector<range_t>& coeff = parent->coefficients();
+            std::size_t i = coeff.size();
+            if (i == 0)
+                return constant;
+            range_t sum = coeff[i-1] / static_cast<domain_t>(i);
+            while (--i > 0)
+                sum = x*sum + coeff[i-1] / static_cast<domain_t>(i);
+            return x*sum + constant;
+        }
+
+        /// @brief Creates a polynomial equal to the integral represented by this view.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            return parent->integral(constant);
+        }
     };
 
 
@@ -359,93 +1679,4292 @@ namespace CosineKitty
     }
 
 
-    /// @brief Derives a polynomial that passes through a given collection of points `(x, y)`.
-    /// @tparam domain_t
-    /// Given a collection of points `(x, y)`, the numeric type of the indepdendent variable `x`.
-    /// It may be a real-like type such as `float` or `double`,
-    /// a complex-like type such as `std::complex<double>`, or even
-    /// a custom type that has analytic properties.
-    /// Not allowed to be integer-like.
-    /// @tparam range_t
-    /// Given a collection of points `(x, y)`, the numeric type of the depdendent variable `y`.
-    /// It may be a real-like type such as `float` or `double`,
-    /// a complex-like type such as `std::complex<double>`, or even
-    /// a custom type that has analytic properties.
-    /// Not allowed to be integer-like.
-    template<typename domain_t, typename range_t>
-    class Interpolator
+    /// @brief Finds the roots of many polynomials, spreading the work across an executor's threads.
+    /// @remarks
+    /// Calls `Polynomial::roots` for each polynomial. Each polynomial is independent,
+    /// so the results are the same regardless of how the work is scheduled.
+    /// The executor may be a #WorkStealingPool or any other type with a member function
+    /// `parallelFor(count, grainSize, func)`, as described for `Polynomial::evaluate`.
+    /// Any exception from `Polynomial::roots`, such as a failure to converge, reaches the caller.
+    /// @param polynomials The polynomials whose roots are wanted. None may be zero.
+    /// @param executor The object that schedules chunks onto threads.
+    /// @param grainSize The number of polynomials per chunk.
+    /// @return The roots of each polynomial, in the same order as the polynomials.
+    template<typename domain_t, typename range_t, typename executor_t, typename = typename std::enable_if<!std::is_same<typename std::decay<executor_t>::type, ParallelOptions>::value>::type>
+    std::vector<std::vector<typename Internal::ComplexOf<range_t>::type>> roots(
+        const std::vector<Polynomial<domain_t, range_t>>& polynomials,
+        executor_t& executor,
+        std::size_t grainSize = 1)
     {
-    private:
-        struct point_t
+        std::vector<std::vector<typename Internal::ComplexOf<range_t>::type>> result(polynomials.size());
+        executor.parallelFor(polynomials.size(), std::max<std::size_t>(1, grainSize), [&](std::size_t begin, std::size_t end)
         {
-            const domain_t x;
-            const range_t  y;
+            for (std::size_t i = begin; i < end; ++i)
+                result[i] = polynomials[i].roots();
+        });
+        return result;
+    }
 
-            point_t(domain_t _x, range_t _y)
-                : x(_x)
-                , y(_y)
-                {}
-        };
 
-        std::vector<point_t> points;
+    /// @brief Finds the roots of many polynomials using multiple threads.
+    /// @remarks
+    /// Every call starts a new #WorkStealingPool and joins its threads before returning,
+    /// so each call pays the cost of creating threads. For repeated calls, create one
+    /// `WorkStealingPool` and pass it to the executor overload of #roots instead.
+    /// A `grainSize` of 0 in the options means one polynomial per chunk.
+    /// @param polynomials The polynomials whose roots are wanted. None may be zero.
+    /// @param options Options that control threading.
+    /// @return The roots of each polynomial, in the same order as the polynomials.
+    template<typename domain_t, typename range_t>
+    std::vector<std::vector<typename Internal::ComplexOf<range_t>::type>> roots(
+        const std::vector<Polynomial<domain_t, range_t>>& polynomials,
+        const ParallelOptions& options)
+    {
+        WorkStealingPool pool(options.threadCount);
+        return roots(polynomials, pool, options.grainSize);
+    }
 
-    public:
-        /// @brief Empties the collection of points inside this interpolator.
-        void clear()
+
+    /// @brief Represents a function as a finite series of Chebyshev polynomials over an interval.
+    /// @remarks
+    /// The series is `f(x) = c0*T0(u) + c1*T1(u) + ... + c[n-1]*T[n-1](u)`, where `Tk` is the
+    /// Chebyshev polynomial of the first kind of degree k, and `u = (2x - (a+b))/(b - a)`
+    /// maps the interval `[a, b]` onto `[-1, +1]`. Unlike monomial coefficients, Chebyshev
+    /// coefficients stay well-conditioned at high degree, so a single series can cover
+    /// a wide interval accurately. Evaluation uses Clenshaw's recurrence.
+    /// Requires a real-like `domain_t`.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the function value `y = f(x)`.
+    template<typename domain_t, typename range_t>
+    class ChebyshevSeries
+    {
+    private:
+        std::vector<range_t> coeff;
+        domain_t lower;
+        domain_t upper;
+        domain_t center;
+        domain_t inverseHalfWidth;
+
+        static constexpr std::size_t evaluateBlockSize = 256;
+
+        domain_t toUnit(domain_t x) const
         {
-            points.clear();
+            return (x - center) * inverseHalfWidth;
         }
 
-        /// @brief Inserts another point `(x, y)` to this interpolator.
-        /// @remarks
-        /// A successful call that inserts a new point will return `true`.
-        /// An interpolator requires a unique value for all `x` values supplied.
-        /// If an `x` value has already been defined by a call to `insert`,
-        /// and the same `x` value is passed again by later call(s) to `insert`,
-        /// the later call(s) will have no effect and return `false`.
-        /// @param x The value of the independent variable `x` for this point.
-        /// @param y The value of the depdendent variable `y` for this point.
-        /// @return If successful, `true`; otherwise `false`. See remarks.
-        bool insert(domain_t x, range_t y)
+        static std::vector<range_t> cosineTransform(const std::vector<range_t>& values)
         {
-            // The x value must never appear more than once,
-            // otherwise there can be inconsistent y values for the same x.
-            // Even if the y values are the same, a duplicate would cause
-            // division by zero later.
-            for (const point_t& p : points)
-                if (p.x == x)
-                    return false;
+            // Returns sum(values[j] * cos(pi*k*(j + 1/2)/n)) for k = 0, ..., n-1 (the DCT-II).
+            using namespace std;
+            const size_t n = values.size();
+            vector<range_t> result(n);
+            const domain_t pi = acos(domain_t{-1});
 
-            points.push_back(point_t{x, y});
-            return true;
+            if constexpr (is_floating_point<range_t>::value)
+            {
+                if (n > 1 && (n & (n-1)) == 0)
+                {
+                    // Makhoul's algorithm: reorder the values, take a complex FFT of the same length,
+                    // then rotate each output by a quarter-sample phase shift.
+                    vector<complex<range_t>> v(n);
+                    for (size_t j = 0; j < n/2; ++j)
+                    {
+                        v[j] = values[2*j];
+                        v[n-1-j] = values[2*j + 1];
+                    }
+                    Internal::fft(v);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        const range_t angle = -pi * static_cast<range_t>(k) / static_cast<range_t>(2*n);
+                        result[k] = real(v[k] * polar(range_t{1}, angle));
+                    }
+                    return result;
+                }
+            }
+
+            // Direct O(n^2) summation for lengths that are not a power of 2.
+            for (size_t k = 0; k < n; ++k)
+                for (size_t j = 0; j < n; ++j)
+                    result[k] += cos(pi * static_cast<domain_t>(k) * (static_cast<domain_t>(j) + domain_t{0.5}) / static_cast<domain_t>(n)) * values[j];
+            return result;
         }
 
-        /// @brief Calculates the unique polynomial that passes through the supplied points.
-        /// @return A polynomial whose value passes through all inserted points.
-        Polynomial<domain_t, range_t> polynomial() const
+    public:
+        /// @brief Creates a Chebyshev series with given coefficients.
+        /// @remarks
+        /// Throws `std::invalid_argument` if the interval is empty.
+        /// @param coefficients The coefficients c0, c1, ..., of T0, T1, ....
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        ChebyshevSeries(const std::vector<range_t>& coefficients, domain_t a = -1, domain_t b = +1)
+            : coeff(coefficients)
+            , lower(a)
+            , upper(b)
+            , center((a + b) / 2)
+            , inverseHalfWidth(2 / (b - a))
         {
-            using namespace std;
-            const size_t n = points.size();
+            if (!(a < b))
+                throw std::invalid_argument("ChebyshevSeries interval must have a < b.");
 
-            Polynomial<domain_t, range_t> sum;
+            const range_t zero = 0;
+            std::size_t i = coeff.size();
+            while (i > 0 && coeff[i-1] == zero)
+                --i;
+            coeff.resize(i);
+        }
+
+        /// @brief Returns the n Chebyshev nodes of the first kind on the interval `[a, b]`.
+        /// @remarks
+        /// The nodes are `x_j = (a+b)/2 + (b-a)/2 * cos(pi*(j + 1/2)/n)`, in decreasing order.
+        /// Interpolating at these nodes avoids the oscillation that equally spaced nodes cause.
+        /// @param n The number of nodes.
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        /// @return A list of n values of x.
+        static std::vector<domain_t> nodes(std::size_t n, domain_t a, domain_t b)
+        {
+            using namespace std;
+            const domain_t pi = acos(domain_t{-1});
+            vector<domain_t> list(n);
             for (size_t j = 0; j < n; ++j)
+                list[j] = (a + b)/2 + (b - a)/2 * cos(pi * (static_cast<domain_t>(j) + domain_t{0.5}) / static_cast<domain_t>(n));
+            return list;
+        }
+
+        /// @brief Creates the Chebyshev series that interpolates values given at the Chebyshev nodes.
+        /// @remarks
+        /// The coefficients are found by a discrete cosine transform. When `range_t` is a
+        /// floating point type and the number of values is a power of 2, the transform uses
+        /// an FFT and costs O(n log n); otherwise it is summed directly in O(n^2).
+        /// @param values The function values at the nodes returned by #nodes, in the same order.
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        /// @return A series of degree n-1 that passes through all the values.
+        static ChebyshevSeries fromNodeValues(const std::vector<range_t>& values, domain_t a, domain_t b)
+        {
+            std::vector<range_t> c = cosineTransform(values);
+            const domain_t n = static_cast<domain_t>(values.size());
+            for (std::size_t k = 0; k < c.size(); ++k)
+                c[k] = ((k == 0) ? (1 / n) : (2 / n)) * c[k];
+            return ChebyshevSeries{c, a, b};
+        }
+
+        /// @brief Creates the Chebyshev series that interpolates a function at n Chebyshev nodes.
+        /// @param func A callable object that returns `f(x)` for a value `x` in the interval.
+        /// @param n The number of nodes, one more than the degree of the series.
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        /// @return A series of degree n-1 that passes through f at the Chebyshev nodes.
+        template<typename func_t>
+        static ChebyshevSeries interpolate(func_t func, std::size_t n, domain_t a, domain_t b)
+        {
+            const std::vector<domain_t> xs = nodes(n, a, b);
+            std::vector<range_t> values(n);
+            for (std::size_t j = 0; j < n; ++j)
+                values[j] = func(xs[j]);
+            return fromNodeValues(values, a, b);
+        }
+
+        /// @brief Converts a polynomial to the equivalent Chebyshev series over an interval.
+        /// @param poly The polynomial to convert.
+        /// @param a The lower end of the interval.
+        /// @param b The upper end of the interval.
+        /// @return A series equal to the polynomial, with the same degree.
+        static ChebyshevSeries fromPolynomial(const Polynomial<domain_t, range_t>& poly, domain_t a, domain_t b)
+        {
+            using namespace std;
+
+            // Rewrite the polynomial in terms of u, where x = (a+b)/2 + u*(b-a)/2.
+            const vector<range_t> q = Internal::substituteLinear(poly.coefficients(), (a + b)/2, (b - a)/2);
+            const size_t n = q.size();
+            if (n == 0)
+                return ChebyshevSeries{vector<range_t>{}, a, b};
+
+            // Horner's method in the Chebyshev basis, using u*T0 = T1 and u*Tk = (T(k-1) + T(k+1))/2.
+            vector<range_t> c(n);
+            vector<range_t> next(n);
+            c[0] = q[n-1];
+            for (size_t i = n-1, degree = 0; i > 0; --i, ++degree)
             {
-                Polynomial<domain_t, range_t> fraction { 1 };
-                for (size_t k = 0; k < n; ++k)
+                fill(next.begin(), next.end(), range_t{0});
+                next[1] = c[0];
+                for (size_t k = 1; k <= degree; ++k)
                 {
-                    if (k != j)
+                    const range_t half = c[k] / domain_t{2};
+                    next[k-1] += half;
+                    next[k+1] += half;
+                }
+                next[0] += q[i-1];
+                swap(c, next);
+            }
+            return ChebyshevSeries{c, a, b};
+        }
+
+        /// @brief Converts this series to the equivalent polynomial in x.
+        /// @return A polynomial equal to this series, with the same degree.
+        Polynomial<domain_t, range_t> toPolynomial() const
+        {
+            using namespace std;
+            const size_t n = coeff.size();
+            if (n == 0)
+                return Polynomial<domain_t, range_t>{};
+
+            // Accumulate c[k]*Tk(u), generating Tk by T(k+1) = 2u*Tk - T(k-1).
+            vector<range_t> sum(n);
+            vector<domain_t> prev(n), curr(n), next(n);
+            curr[0] = 1;
+            for (size_t k = 0; k < n; ++k)
+            {
+                for (size_t i = 0; i <= k; ++i)
+                    sum[i] += curr[i] * coeff[k];
+
+                if (k+1 < n)
+                {
+                    for (size_t i = 0; i <= k+1; ++i)
+                    {
+                        const domain_t shifted = (i > 0) ? curr[i-1] : domain_t{0};
+                        next[i] = (k == 0 ? 1 : 2) * shifted - prev[i];
+                    }
+                    swap(prev, curr);
+                    swap(curr, next);
+                }
+            }
+
+            // Substitute u = (x - center)/halfWidth.
+            return Polynomial<domain_t, range_t>{Internal::substituteLinear(sum, -center*inverseHalfWidth, inverseHalfWidth)};
+        }
+
+        /// @brief Allows read-only access to the Chebyshev coefficients.
+        const std::vector<range_t>& coefficients() const
+        {
+            return coeff;
+        }
+
+        /// @brief Returns the lower end of the interval.
+        domain_t lowerBound() const
+        {
+            return lower;
+        }
+
+        /// @brief Returns the upper end of the interval.
+        domain_t upperBound() const
+        {
+            return upper;
+        }
+
+        /// @brief Evaluates the series for a given value of x, using Clenshaw's recurrence.
+        /// @param x The value of the independent variable.
+        /// @return The value of the series at x.
+        range_t operator() (domain_t x) const
+        {
+            // b[k] = c[k] + 2u*b[k+1] - b[k+2], then f = c[0] + u*b[1] - b[2].
+            const domain_t u = toUnit(x);
+            const domain_t twoU = 2*u;
+            range_t b1 = 0;
+            range_t b2 = 0;
+            std::size_t k = coeff.size();
+            if (k == 0)
+                return b1;
+            while (--k > 0)
+            {
+                const range_t b0 = coeff[k] + twoU*b1 - b2;
+                b2 = b1;
+                b1 = b0;
+            }
+            return coeff[0] + u*b1 - b2;
+        }
+
+        /// @brief Evaluates the series for an array of x values.
+        /// @remarks
+        /// Like `Polynomial::evaluate`, values are stepped through the recurrence
+        /// together in small blocks so the compiler can vectorize the inner loop.
+        /// The input and output arrays must not overlap.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the values f(x).
+        /// @param count The number of values to evaluate.
+        void evaluate(const domain_t* x, range_t* y, std::size_t count) const
+        {
+            using namespace std;
+            const size_t n = coeff.size();
+            domain_t u[evaluateBlockSize];
+            range_t b1[evaluateBlockSize];
+            range_t b2[evaluateBlockSize];
+            for (size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const size_t len = min(evaluateBlockSize, count - start);
+                for (size_t i = 0; i < len; ++i)
+                {
+                    u[i] = toUnit(x[start + i]);
+                    b1[i] = b2[i] = 0;
+                }
+                for (size_t k = n; k > 1; --k)
+                {
+                    const range_t c = coeff[k-1];
+                    for (size_t i = 0; i < len; ++i)
+                    {
+                        const range_t b0 = c + 2*u[i]*b1[i] - b2[i];
+                        b2[i] = b1[i];
+                        b1[i] = b0;
+                    }
+                }
+                const range_t c0 = (n > 0) ? coeff[0] : range_t{0};
+                for (size_t i = 0; i < len; ++i)
+                    y[start + i] = c0 + u[i]*b1[i] - b2[i];
+            }
+        }
+
+        /// @brief Takes the derivative of this series with respect to x.
+        /// @return A new series over the same interval equal to the derivative.
+        ChebyshevSeries derivative() const
+        {
+            // d[k-1] = d[k+1] + 2k*c[k], working down from the top, then halve d[0].
+            using namespace std;
+            const size_t n = coeff.size();
+            if (n <= 1)
+                return ChebyshevSeries{vector<range_t>{}, lower, upper};
+
+            vector<range_t> d(n+1);
+            for (size_t k = n-1; k > 0; --k)
+                d[k-1] = d[k+1] + static_cast<domain_t>(2*k) * coeff[k];
+            d[0] = d[0] / domain_t{2};
+            d.resize(n-1);
+            for (range_t& e : d)
+                e = inverseHalfWidth * e;
+            return ChebyshevSeries{d, lower, upper};
+        }
+
+        /// @brief Takes the indefinite integral of this series with respect to x.
+        /// @param valueAtLower The value of the integral at the lower end of the interval.
+        /// @return A new series over the same interval equal to the integral.
+        ChebyshevSeries integral(range_t valueAtLower = 0) const
+        {
+            using namespace std;
+            const size_t n = coeff.size();
+            vector<range_t> c(coeff);
+            c.resize(n + 2);
+            vector<range_t> C(n + 1);
+            const domain_t halfWidth = 1 / inverseHalfWidth;
+            if (n > 0)
+            {
+                // The integral of T0 is T1, the integral of T1 is T2/4, and for k >= 2
+                // the integral of Tk is T(k+1)/(2(k+1)) - T(k-1)/(2(k-1)).
+                C[1] = halfWidth * (c[0] - c[2] / domain_t{2});
+                for (size_t k = 2; k <= n; ++k)
+                    C[k] = halfWidth * (c[k-1] - c[k+1]) / static_cast<domain_t>(2*k);
+            }
+
+            // Choose the constant term so the integral has the requested value at u = -1, where Tk = (-1)^k.
+            range_t sum = 0;
+            for (size_t k = 1; k <= n; ++k)
+                sum += (k & 1) ? -C[k] : C[k];
+            C[0] = valueAtLower - sum;
+            return ChebyshevSeries{C, lower, upper};
+        }
+    };
+
+
+    /// @brief Finds the minimax polynomial approximation of a function, using the Remez exchange algorithm.
+    /// @remarks
+    /// The result is the polynomial of the given degree whose largest error magnitude
+    /// over `[a, b]` is as small as possible. Compared with interpolating the function at
+    /// fixed nodes, the minimax polynomial reaches a given accuracy with fewer coefficients.
+    /// The algorithm starts from the Chebyshev extrema and repeatedly solves for a polynomial
+    /// whose error alternates in sign with equal magnitude on a reference set of `degree+2` points,
+    /// then moves the reference to the extrema of the actual error, until the two agree.
+    /// Internally the polynomial is represented as a Chebyshev series for good conditioning,
+    /// and converted to a `Polynomial` at the end.
+    /// The function should be continuous on the interval.
+    /// Throws #ConvergenceError if the errors on the reference set have not leveled out
+    /// after 60 exchanges, and `std::runtime_error` if a reference system is singular;
+    /// either can happen when the function is not continuous.
+    /// @tparam real_t A real floating point type for both x and f(x).
+    /// @param func A callable object that returns f(x) for any x in `[a, b]`.
+    /// @param a The lower end of the interval.
+    /// @param b The upper end of the interval.
+    /// @param degree The degree of the approximating polynomial.
+    /// @param maxError If not null, receives the largest error magnitude of the result over the interval.
+    /// @return The minimax polynomial of the given degree.
+    template<typename real_t, typename func_t>
+    Polynomial<real_t, real_t> minimax(func_t func, real_t a, real_t b, std::size_t degree, real_t* maxError = nullptr)
+    {
+        using namespace std;
+
+        if (!(a < b))
+            throw invalid_argument("minimax interval must have a < b.");
+
+        const size_t m = degree + 2;
+        const real_t pi = acos(real_t{-1});
+        const real_t center = (a + b) / 2;
+        const real_t halfWidth = (b - a) / 2;
+        auto g = [&](real_t u) -> real_t { return func(center + halfWidth*u); };
+
+        // The reference starts at the extrema of the Chebyshev polynomial T(degree+1).
+        vector<real_t> ref(m);
+        for (size_t i = 0; i < m; ++i)
+            ref[i] = -cos(pi * static_cast<real_t>(i) / static_cast<real_t>(m-1));
+
+        vector<real_t> c(degree + 1);
+        real_t worst = 0;
+        bool converged = false;
+        const int maxIterations = 60;
+        for (int iter = 0; iter < maxIterations && !converged; ++iter)
+        {
+            // Solve sum(c[k]*Tk(u_i)) + (-1)^i*E = g(u_i) for the coefficients c and the level error E.
+            vector<real_t> A(m*m);
+            vector<real_t> rhs(m);
+            real_t magnitude = 0;
+            for (size_t i = 0; i < m; ++i)
+            {
+                real_t t0 = 1;
+                real_t t1 = ref[i];
+                for (size_t k = 0; k <= degree; ++k)
+                {
+                    A[i*m + k] = t0;
+                    const real_t t2 = 2*ref[i]*t1 - t0;
+                    t0 = t1;
+                    t1 = t2;
+                }
+                A[i*m + m-1] = (i & 1) ? -1 : +1;
+                rhs[i] = g(ref[i]);
+                magnitude = max(magnitude, abs(rhs[i]));
+            }
+            Internal::solveLinearSystem(A, rhs);
+            copy(rhs.begin(), rhs.begin() + degree + 1, c.begin());
+            const real_t level = abs(rhs[m-1]);
+
+            const ChebyshevSeries<real_t, real_t> p{c};
+            auto err = [&](real_t u) -> real_t { return g(u) - p(u); };
+
+            // Find where the error crosses zero between consecutive reference points.
+            vector<real_t> bounds(m+1);
+            bounds[0] = -1;
+            bounds[m] = +1;
+            for (size_t i = 0; i+1 < m; ++i)
+            {
+                real_t lo = ref[i];
+                real_t hi = ref[i+1];
+                real_t elo = err(lo);
+                if (elo * err(hi) < 0)
+                {
+                    for (int k = 0; k < 100 && lo < hi; ++k)
+                    {
+                        const real_t mid = (lo + hi) / 2;
+                        if (mid <= lo || mid >= hi)
+                            break;
+                        const real_t emid = err(mid);
+                        if ((emid < 0) == (elo < 0))
+                        {
+                            lo = mid;
+                            elo = emid;
+                        }
+                        else
+                            hi = mid;
+                    }
+                }
+                bounds[i+1] = (lo + hi) / 2;
+            }
+
+            // Between consecutive zeros, move each reference point to the largest error.
+            worst = 0;
+            for (size_t i = 0; i < m; ++i)
+            {
+                const real_t lo = bounds[i];
+                const real_t hi = bounds[i+1];
+                const int samples = 16;
+                real_t best = lo;
+                real_t bestSize = abs(err(lo));
+                for (int k = 1; k <= samples; ++k)
+                {
+                    const real_t u = lo + (hi - lo) * static_cast<real_t>(k) / samples;
+                    const real_t size = abs(err(u));
+                    if (size > bestSize)
                     {
-                        // fraction *= (x - x_k)/(x_j - x_k)
-                        domain_t denom = points[j].x - points[k].x;
-                        fraction *= Polynomial<domain_t, range_t>{-points[k].x / denom, 1 / denom};
+                        best = u;
+                        bestSize = size;
                     }
                 }
-                sum += points[j].y * fraction;
+
+                // Refine by golden section search around the best sample.
+                const real_t step = (hi - lo) / samples;
+                real_t left = max(lo, best - step);
+                real_t right = min(hi, best + step);
+                const real_t ratio = (sqrt(real_t{5}) - 1) / 2;
+                for (int k = 0; k < 60; ++k)
+                {
+                    const real_t x1 = right - ratio*(right - left);
+                    const real_t x2 = left + ratio*(right - left);
+                    if (abs(err(x1)) < abs(err(x2)))
+                        left = x1;
+                    else
+                        right = x2;
+                }
+                const real_t refined = (left + right) / 2;
+                const real_t refinedSize = abs(err(refined));
+                if (refinedSize > bestSize)
+                {
+                    best = refined;
+                    bestSize = refinedSize;
+                }
+
+                ref[i] = best;
+                worst = max(worst, bestSize);
+            }
+
+            // Stop when the errors at the reference points have (nearly) leveled out,
+            // or differ only by rounding error in the function values.
+            const real_t noise = 64 * numeric_limits<real_t>::epsilon() * magnitude;
+            converged = (worst - level <= 1.0e-6 * worst + noise + numeric_limits<real_t>::min());
+        }
+
+        if (!converged)
+            throw ConvergenceError("minimax did not converge.");
+
+        if (maxError)
+            *maxError = worst;
+
+        return ChebyshevSeries<real_t, real_t>{c, a, b}.toPolynomial();
+    }
+
+
+    /// @brief Finds the lowest-degree minimax polynomial that approximates a function within a tolerance.
+    /// @remarks
+    /// Tries each degree in turn, starting from 0, using #minimax.
+    /// A degree for which #minimax does not converge is skipped.
+    /// Throws `std::range_error` if no degree up to `maxDegree` meets the tolerance,
+    /// or #ConvergenceError if no degree met it and some degree did not converge.
+    /// A `std::runtime_error` from a singular reference system is passed on.
+    /// @tparam real_t A real floating point type for both x and f(x).
+    /// @param func A callable object that returns f(x) for any x in `[a, b]`.
+    /// @param a The lower end of the interval.
+    /// @param b The upper end of the interval.
+    /// @param tolerance The largest allowed error magnitude over the interval.
+    /// @param maxDegree The highest degree to try.
+    /// @param maxError If not null, receives the largest error magnitude of the result over the interval.
+    /// @return The minimax polynomial of the lowest degree whose error is within the tolerance.
+    template<typename real_t, typename func_t>
+    Polynomial<real_t, real_t> minimaxForTolerance(
+        func_t func,
+        real_t a,
+        real_t b,
+        real_t tolerance,
+        std::size_t maxDegree,
+        real_t* maxError = nullptr)
+    {
+        bool skipped = false;
+        for (std::size_t degree = 0; degree <= maxDegree; ++degree)
+        {
+            real_t error;
+            Polynomial<real_t, real_t> poly;
+            try
+            {
+                poly = minimax(func, a, b, degree, &error);
+            }
+            catch (const ConvergenceError&)
+            {
+                // A degree that does not converge says nothing about higher degrees.
+                skipped = true;
+                continue;
+            }
+            if (error <= tolerance)
+            {
+                if (maxError)
+                    *maxError = error;
+                return poly;
             }
+        }
+        if (skipped)
+            throw ConvergenceError("No minimax polynomial up to the maximum degree converged within the tolerance.");
+        throw std::range_error("No minimax polynomial up to the maximum degree meets the tolerance.");
+    }
+
+
+    /// @brief A function made of many low-degree polynomial segments joined end to end.
+    /// @remarks
+    /// The segments are separated by an increasing list of breakpoints.
+    /// Each segment is a polynomial in the local variable `t = x - x_s`,
+    /// where `x_s` is the breakpoint at the left end of the segment.
+    /// The coefficients of all segments are packed into one contiguous, cache-aligned table,
+    /// with the same number of coefficients per segment.
+    /// When the breakpoints are equally spaced, finding the segment for a given x
+    /// takes constant time. Otherwise a branchless binary search is used.
+    /// Values of x outside the breakpoints are extrapolated from the first or last segment.
+    /// Requires a real-like `domain_t` that can be ordered with `<`.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the function value `y = f(x)`.
+    template<typename domain_t, typename range_t>
+    class PiecewisePolynomial
+    {
+    public:
+        /// @brief The container type for the packed table of segment coefficients.
+        using table_t = std::vector<range_t, AlignedAllocator<range_t>>;
 
+    private:
+        std::vector<domain_t> breaks;
+        std::size_t stride;
+        table_t table;
+        bool uniform;
+        domain_t origin;
+        domain_t inverseStep;
+
+        static constexpr std::size_t evaluateBlockSize = 256;
+
+        range_t evaluateSegment(std::size_t s, domain_t x) const
+        {
+            const range_t* c = table.data() + s*stride;
+            const domain_t t = x - breaks[s];
+            if (stride == 4)
+                return ((c[3]*t + c[2])*t + c[1])*t + c[0];   // cubic splines
+            std::size_t k = stride;
+            range_t sum = c[--k];
+            while (k > 0)
+                sum = t*sum + c[--k];
             return sum;
         }
+
+    public:
+        /// @brief Creates a piecewise polynomial from a packed table of segment coefficients.
+        /// @remarks
+        /// Throws `std::invalid_argument` if there are fewer than 2 breakpoints,
+        /// the breakpoints are not strictly increasing, `coefficientsPerSegment` is zero,
+        /// or the table does not have exactly `coefficientsPerSegment` entries per segment.
+        /// @param breakpoints The increasing values of x that separate the segments, including both ends.
+        /// @param coefficientsPerSegment The number of coefficients in each segment.
+        /// @param coefficients
+        /// The coefficients of each segment in turn, in increasing order of power of `t`.
+        PiecewisePolynomial(
+            const std::vector<domain_t>& breakpoints,
+            std::size_t coefficientsPerSegment,
+            const std::vector<range_t>& coefficients)
+            : breaks(breakpoints)
+            , stride(coefficientsPerSegment)
+            , table(coefficients.begin(), coefficients.end())
+            , uniform(false)
+            , origin(0)
+            , inverseStep(0)
+        {
+            using namespace std;
+
+            const size_t n = breaks.size();
+            if (n < 2)
+                throw invalid_argument("PiecewisePolynomial requires at least 2 breakpoints.");
+
+            if (stride == 0 || table.size() != (n-1)*stride)
+                throw invalid_argument("PiecewisePolynomial coefficient table has the wrong size.");
+
+            for (size_t i = 1; i < n; ++i)
+                if (!(breaks[i-1] < breaks[i]))
+                    throw invalid_argument("PiecewisePolynomial breakpoints must be strictly increasing.");
+
+            // Detect equally spaced breakpoints, allowing for rounding errors.
+            const domain_t step = (breaks[n-1] - breaks[0]) / static_cast<domain_t>(n-1);
+            const domain_t tolerance = 16 * numeric_limits<domain_t>::epsilon() * max(abs(breaks[0]), abs(breaks[n-1]));
+            uniform = true;
+            for (size_t i = 1; i+1 < n && uniform; ++i)
+                uniform = abs(breaks[i] - (breaks[0] + static_cast<domain_t>(i)*step)) <= tolerance;
+            origin = breaks[0];
+            inverseStep = 1 / step;
+        }
+
+        /// @brief Returns the number of polynomial segments.
+        std::size_t segmentCount() const
+        {
+            return breaks.size() - 1;
+        }
+
+        /// @brief Returns the number of coefficients stored for each segment.
+        std::size_t coefficientsPerSegment() const
+        {
+            return stride;
+        }
+
+        /// @brief Returns the breakpoints, including both ends.
+        const std::vector<domain_t>& breakpoints() const
+        {
+            return breaks;
+        }
+
+        /// @brief Returns the packed table of segment coefficients.
+        const table_t& coefficients() const
+        {
+            return table;
+        }
+
+        /// @brief Indicates whether the breakpoints are equally spaced, allowing constant-time segment lookup.
+        bool isUniform() const
+        {
+            return uniform;
+        }
+
+        /// @brief Finds the index of the segment used to evaluate a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The index of the segment whose interval contains x, or the nearest end segment.
+        std::size_t segment(domain_t x) const
+        {
+            const std::size_t last = breaks.size() - 2;
+            if (uniform)
+            {
+                // Clamp to the end segments with selects rather than early returns.
+                domain_t u = (x - origin) * inverseStep;
+                u = (u > 0) ? u : domain_t{0};
+                u = (u < static_cast<domain_t>(last)) ? u : static_cast<domain_t>(last);
+                std::size_t s = static_cast<std::size_t>(u);
+                // Correct for rounding errors, so that breaks[s] <= x < breaks[s+1].
+                s += static_cast<std::size_t>(s < last && !(x < breaks[s+1]));
+                s -= static_cast<std::size_t>(s > 0 && x < breaks[s]);
+                return s;
+            }
+
+            // Branchless binary search for the last left endpoint that is <= x.
+            const domain_t* base = breaks.data();
+            std::size_t n = last + 1;
+            while (n > 1)
+            {
+                const std::size_t half = n / 2;
+                base = (base[half] <= x) ? (base + half) : base;
+                n -= half;
+            }
+            return static_cast<std::size_t>(base - breaks.data());
+        }
+
+        /// @brief Evaluates the piecewise polynomial for a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The value of the function at x.
+        range_t operator() (domain_t x) const
+        {
+            return evaluateSegment(segment(x), x);
+        }
+
+        /// @brief Evaluates the piecewise polynomial for an array of x values in any order.
+        /// @remarks
+        /// The segment lookups for a block of inputs are done first, in their own loop,
+        /// so the Horner loop that follows has no branches and can be vectorized
+        /// by the compiler where the target supports gathers.
+        /// When the inputs are already sorted, #evaluateSorted avoids the lookups entirely.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the function values.
+        /// @param count The number of values to evaluate.
+        void evaluate(const domain_t* x, range_t* y, std::size_t count) const
+        {
+            // Work in blocks: first look up every segment, then evaluate the block
+            // in a separate loop with no searching or branching.
+            std::size_t seg[evaluateBlockSize];
+            for (std::size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const std::size_t n = std::min(count - start, evaluateBlockSize);
+                const domain_t* xb = x + start;
+                range_t* yb = y + start;
+                for (std::size_t i = 0; i < n; ++i)
+                    seg[i] = segment(xb[i]);
+
+                if (stride == 4)
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        const range_t* c = table.data() + 4*seg[i];
+                        const domain_t t = xb[i] - breaks[seg[i]];
+                        yb[i] = ((c[3]*t + c[2])*t + c[1])*t + c[0];
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                        yb[i] = evaluateSegment(seg[i], xb[i]);
+                }
+            }
+        }
+
+        /// @brief Evaluates the piecewise polynomial for an array of x values in nondecreasing order.
+        /// @remarks
+        /// Walks forward through the segments along with the queries, instead of searching
+        /// for each one, so the lookup cost is amortized constant time per query.
+        /// The results are unspecified if the x values are not sorted.
+        /// @param x An array of `count` values of the independent variable, sorted in nondecreasing order.
+        /// @param y An array of `count` elements that receives the function values.
+        /// @param count The number of values to evaluate.
+        void evaluateSorted(const domain_t* x, range_t* y, std::size_t count) const
+        {
+            if (count == 0)
+                return;
+            const std::size_t last = breaks.size() - 2;
+            std::size_t s = segment(x[0]);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                while (s < last && !(x[i] < breaks[s+1]))
+                    ++s;
+                y[i] = evaluateSegment(s, x[i]);
+            }
+        }
+    };
+
+
+    /// @brief Selects how generated code evaluates a polynomial.
+    enum class EvaluationScheme
+    {
+        Horner,     ///< Nested multiply-add, one coefficient at a time. Fewest operations.
+        Estrin,     ///< Pairwise combination by powers of x. Shorter dependency chains.
+    };
+
+
+    /// @brief Options that control the source code emitted by #generateCode.
+    struct CodeGenOptions
+    {
+        /// @brief The name of the generated function.
+        std::string functionName = "evaluate";
+
+        /// @brief The order in which the generated function combines the coefficients.
+        EvaluationScheme scheme = EvaluationScheme::Horner;
+
+        /// @brief Whether to use `std::fma` for each multiply-add, instead of separate operations.
+        bool useFma = true;
+
+        /// @brief Whether to also emit `<functionName>_batch`, which evaluates an array of x values.
+        /// @remarks
+        /// The batch function is a plain loop over the inlined scalar function,
+        /// written so that the compiler can vectorize it.
+        bool batch = false;
+
+        /// @brief Whether to begin the output with `#pragma once` and the required `#include` lines.
+        /// @remarks Set to false when appending several generated functions to the same file.
+        bool preamble = true;
     };
+
+
+    namespace Internal
+    {
+        template<typename real_t>
+        const char* codeTypeName()
+        {
+            static_assert(std::is_floating_point<real_t>::value, "Code generation requires float, double, or long double.");
+            if (std::is_same<real_t, float>::value)
+                return "float";
+            if (std::is_same<real_t, double>::value)
+                return "double";
+            return "long double";
+        }
+
+        template<typename real_t>
+        std::string codeLiteral(real_t value)
+        {
+            // Writes enough digits that the compiler reads back the exact same value.
+            using namespace std;
+            if (!isfinite(value))
+                throw invalid_argument("Cannot generate code for a coefficient that is not finite.");
+            ostringstream text;
+            text.imbue(locale::classic());
+            text.precision(numeric_limits<real_t>::max_digits10 - 1);
+            text << scientific << value;
+            if (is_same<real_t, float>::value)
+                text << "f";
+            else if (is_same<real_t, long double>::value)
+                text << "L";
+            return text.str();
+        }
+
+        template<typename real_t>
+        void codeArray(std::ostream& out, const std::string& name, const real_t* values, std::size_t count)
+        {
+            out << "inline constexpr " << codeTypeName<real_t>() << " " << name << "[" << count << "] =\n{\n";
+            for (std::size_t i = 0; i < count; ++i)
+                out << "    " << codeLiteral(values[i]) << ",\n";
+            out << "};\n\n";
+        }
+
+        inline std::string codeMultiplyAdd(const std::string& a, const std::string& b, const std::string& c, bool useFma)
+        {
+            if (useFma)
+                return "std::fma(" + a + ", " + b + ", " + c + ")";
+            return a + "*" + b + " + " + c;
+        }
+
+        // Writes statements that evaluate the polynomial with coefficients c[0..count-1]
+        // at the variable `var`, ending with a return statement.
+        inline void codePolynomialBody(
+            std::ostream& out,
+            const char* typeName,
+            const std::string& c,
+            const std::string& var,
+            std::size_t count,
+            const CodeGenOptions& options)
+        {
+            using namespace std;
+            const string indent = "    ";
+            auto coeff = [&](size_t k) { return c + "[" + to_string(k) + "]"; };
+
+            if (count == 1)
+            {
+                out << indent << "return " << coeff(0) << ";\n";
+                return;
+            }
+
+            if (options.scheme == EvaluationScheme::Horner)
+            {
+                out << indent << typeName << " y = " << coeff(count-1) << ";\n";
+                for (size_t k = count-1; k > 0; --k)
+                    out << indent << "y = " << codeMultiplyAdd("y", var, coeff(k-1), options.useFma) << ";\n";
+                out << indent << "return y;\n";
+                return;
+            }
+
+            // Estrin: combine adjacent terms using x, then adjacent pairs using x^2, x^4, ...
+            vector<string> terms;
+            for (size_t k = 0; k < count; ++k)
+                terms.push_back(coeff(k));
+
+            string power = var;
+            for (unsigned level = 0; terms.size() > 1; ++level)
+            {
+                if (level > 0)
+                {
+                    const string next = var + to_string(size_t{1} << level);
+                    out << indent << "const " << typeName << " " << next << " = " << power << "*" << power << ";\n";
+                    power = next;
+                }
+                vector<string> combined;
+                for (size_t i = 0; i+1 < terms.size(); i += 2)
+                {
+                    const string name = "e" + to_string(level) + "_" + to_string(i/2);
+                    out << indent << "const " << typeName << " " << name << " = " << codeMultiplyAdd(terms[i+1], power, terms[i], options.useFma) << ";\n";
+                    combined.push_back(name);
+                }
+                if (terms.size() & 1)
+                    combined.push_back(terms.back());
+                terms.swap(combined);
+            }
+            out << indent << "return " << terms[0] << ";\n";
+        }
+
+        inline void codePreamble(std::ostream& out, const CodeGenOptions& options)
+        {
+            if (options.preamble)
+                out << "// Generated by CosineKitty::generateCode.\n#pragma once\n#include <cmath>\n#include <cstddef>\n\n";
+        }
+
+        inline void codeBatch(std::ostream& out, const char* typeName, const CodeGenOptions& options)
+        {
+            if (options.batch)
+            {
+                const std::string& name = options.functionName;
+                out << "inline void " << name << "_batch(const " << typeName << "* x, " << typeName << "* y, std::size_t count)\n{\n";
+                out << "    for (std::size_t i = 0; i < count; ++i)\n";
+                out << "        y[i] = " << name << "(x[i]);\n";
+                out << "}\n\n";
+            }
+        }
+    }
+
+
+    /// @brief Writes C++ source code for a function that evaluates a given polynomial.
+    /// @remarks
+    /// The output defines a `constexpr` array `<functionName>_coefficients` and an inline
+    /// function `<functionName>(x)` whose body is unrolled into straight-line multiply-add
+    /// operations, so the compiler can treat the fitted curve like hand-written code.
+    /// Coefficients are written with enough digits to reproduce them exactly.
+    /// Both `domain_t` and `range_t` must be `float`, `double`, or `long double`.
+    /// Throws `std::invalid_argument` if any coefficient is infinite or NaN.
+    /// @param out The stream that receives the source code.
+    /// @param poly The polynomial to evaluate.
+    /// @param options Options that control the generated code.
+    template<typename domain_t, typename range_t>
+    void generateCode(std::ostream& out, const Polynomial<domain_t, range_t>& poly, const CodeGenOptions& options = CodeGenOptions{})
+    {
+        using namespace std;
+        const char* domainName = Internal::codeTypeName<domain_t>();
+        const char* rangeName = Internal::codeTypeName<range_t>();
+
+        vector<range_t> coeffs = poly.coefficients();
+        if (coeffs.empty())
+            coeffs.push_back(range_t{0});
+
+        const string& name = options.functionName;
+        Internal::codePreamble(out, options);
+        Internal::codeArray(out, name + "_coefficients", coeffs.data(), coeffs.size());
+        out << "inline " << rangeName << " " << name << "(" << domainName << " x)\n{\n";
+        out << "    const " << rangeName << "* c = " << name << "_coefficients;\n";
+        Internal::codePolynomialBody(out, rangeName, "c", "x", coeffs.size(), options);
+        out << "}\n\n";
+        Internal::codeBatch(out, rangeName, options);
+    }
+
+
+    /// @brief Writes C++ source code for a function that evaluates a given piecewise polynomial.
+    /// @remarks
+    /// The output defines `constexpr` arrays `<functionName>_breakpoints` and
+    /// `<functionName>_coefficients`, and an inline function `<functionName>(x)`
+    /// that finds the segment the same way `PiecewisePolynomial` does and
+    /// evaluates it with an unrolled body.
+    /// Both `domain_t` and `range_t` must be the same type: `float`, `double`, or `long double`.
+    /// Throws `std::invalid_argument` if any breakpoint or coefficient is infinite or NaN.
+    /// @param out The stream that receives the source code.
+    /// @param piecewise The piecewise polynomial to evaluate.
+    /// @param options Options that control the generated code.
+    template<typename domain_t, typename range_t>
+    void generateCode(std::ostream& out, const PiecewisePolynomial<domain_t, range_t>& piecewise, const CodeGenOptions& options = CodeGenOptions{})
+    {
+        using namespace std;
+        static_assert(is_same<domain_t, range_t>::value, "Piecewise code generation requires domain_t and range_t to be the same type.");
+        const char* typeName = Internal::codeTypeName<range_t>();
+
+        const vector<domain_t>& breaks = piecewise.breakpoints();
+        const size_t stride = piecewise.coefficientsPerSegment();
+        const size_t last = piecewise.segmentCount() - 1;
+
+        const string& name = options.functionName;
+        Internal::codePreamble(out, options);
+        Internal::codeArray(out, name + "_breakpoints", breaks.data(), breaks.size());
+        Internal::codeArray(out, name + "_coefficients", piecewise.coefficients().data(), piecewise.coefficients().size());
+
+        out << "inline " << typeName << " " << name << "(" << typeName << " x)\n{\n";
+        out << "    const " << typeName << "* breaks = " << name << "_breakpoints;\n";
+        out << "    std::size_t s = 0;\n";
+        if (last > 0)
+        {
+            if (piecewise.isUniform())
+            {
+                const domain_t inverseStep = static_cast<domain_t>(last + 1) / (breaks.back() - breaks.front());
+                out << "    const " << typeName << " u = (x - breaks[0]) * " << Internal::codeLiteral(inverseStep) << ";\n";
+                out << "    if (u > 0)\n";
+                out << "    {\n";
+                out << "        s = (u >= " << last << ") ? " << last << " : static_cast<std::size_t>(u);\n";
+                out << "        if (s < " << last << " && !(x < breaks[s+1]))\n";
+                out << "            ++s;\n";
+                out << "        else if (s > 0 && x < breaks[s])\n";
+                out << "            --s;\n";
+                out << "    }\n";
+            }
+            else
+            {
+                out << "    const " << typeName << "* base = breaks;\n";
+                out << "    std::size_t n = " << (last + 1) << ";\n";
+                out << "    while (n > 1)\n";
+                out << "    {\n";
+                out << "        const std::size_t half = n / 2;\n";
+                out << "        base = (base[half] <= x) ? (base + half) : base;\n";
+                out << "        n -= half;\n";
+                out << "    }\n";
+                out << "    s = static_cast<std::size_t>(base - breaks);\n";
+            }
+        }
+        out << "    const " << typeName << "* c = " << name << "_coefficients + s*" << stride << ";\n";
+        out << "    const " << typeName << " t = x - breaks[s];\n";
+        Internal::codePolynomialBody(out, typeName, "c", "t", stride, options);
+        out << "}\n\n";
+        Internal::codeBatch(out, typeName, options);
+    }
+
+
+    namespace Internal
+    {
+        // The point loaders append to an interpolator directly; see loadCsvPoints and loadBinaryPoints.
+        template<typename domain_t, typename range_t> class CsvPointParser;
+        template<typename domain_t, typename range_t> class BinaryPointDecoder;
+    }
+
+
+    /// @brief Derives a polynomial that passes through a given collection of points `(x, y)`.
+    /// @tparam domain_t
+    /// Given a collection of points `(x, y)`, the numeric type of the indepdendent variable `x`.
+    /// It may be a real-like type such as `float` or `double`,
+    /// a complex-like type such as `std::complex<double>`, or even
+    /// a custom type that has analytic properties.
+    /// Not allowed to be integer-like.
+    /// @tparam range_t
+    /// Given a collection of points `(x, y)`, the numeric type of the depdendent variable `y`.
+    /// It may be a real-like type such as `float` or `double`,
+    /// a complex-like type such as `std::complex<double>`, or even
+    /// a custom type that has analytic properties.
+    /// Not allowed to be integer-like.
+    template<typename domain_t, typename range_t>
+    class Interpolator
+    {
+    private:
+        struct point_t
+        {
+            domain_t x;
+            range_t  y;
+
+            point_t(domain_t _x, range_t _y)
+                : x(_x)
+                , y(_y)
+                {}
+        };
+
+        std::vector<point_t> points;
+
+        // For real-valued x, a second copy of the inserted x values in increasing order,
+        // so that duplicates can be found by binary search instead of a linear scan.
+        // It is built only when points are first inserted in bulk, so interpolators
+        // filled one point at a time do not pay for the extra copy.
+        static constexpr bool ordered = std::is_arithmetic<domain_t>::value;
+        std::vector<domain_t> sortedX;
+        bool indexed = false;
+
+        static void rejectNaN(domain_t x)
+        {
+            // NaN compares false with everything, which would break the sorted order.
+            if (std::isnan(x))
+                throw std::invalid_argument("Interpolator x value must not be NaN.");
+        }
+
+        // In deterministic parallel mode, the number of points summed by each task.
+        static constexpr std::size_t deterministicBlockSize = 8;
+
+        template<typename, typename> friend class Internal::CsvPointParser;
+        template<typename, typename> friend class Internal::BinaryPointDecoder;
+
+        // Adds points without checking for duplicate x values yet, so that a large load
+        // can be appended in chunks and checked once by #commit. Throws before appending
+        // anything if any real-valued x is NaN.
+        void append(const domain_t* x, const range_t* y, std::size_t count)
+        {
+            if constexpr (ordered)
+            {
+                if (count == 0)
+                    return;
+                for (std::size_t i = 0; i < count; ++i)
+                    rejectNaN(x[i]);
+                if (!indexed)
+                {
+                    sortedX.resize(points.size());
+                    for (std::size_t i = 0; i < points.size(); ++i)
+                        sortedX[i] = points[i].x;
+                    std::sort(sortedX.begin(), sortedX.end());
+                    indexed = true;
+                }
+                sortedX.insert(sortedX.end(), x, x + count);
+                points.reserve(points.size() + count);
+                for (std::size_t i = 0; i < count; ++i)
+                    points.push_back(point_t{x[i], y[i]});
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    insert(x[i], y[i]);
+            }
+        }
+
+        // Checks the points appended since `start` for duplicate x values, keeping the first
+        // of any equal values, then merges them into the sorted index.
+        // Costs O(m*log(n)) for m appended points plus one linear merge.
+        // Returns the number of points kept.
+        std::size_t commit(std::size_t start)
+        {
+            using namespace std;
+            if constexpr (ordered)
+            {
+                if (points.size() == start)
+                    return 0;
+
+                const auto prefix = sortedX.begin() + start;
+                sort(prefix, sortedX.end());
+
+                // Find the x values that are already present, or repeated among the new points.
+                vector<domain_t> repeated;
+                for (auto it = prefix; it != sortedX.end(); ++it)
+                    if ((it+1 != sortedX.end() && *(it+1) == *it) || binary_search(sortedX.begin(), prefix, *it))
+                        if (repeated.empty() || repeated.back() != *it)
+                            repeated.push_back(*it);
+
+                if (!repeated.empty())
+                {
+                    // Drop the new points whose x was already present, and all but the first
+                    // of the new points that share an x value, preserving insertion order.
+                    vector<bool> seen(repeated.size(), false);
+                    size_t kept = start;
+                    for (size_t i = start; i < points.size(); ++i)
+                    {
+                        const domain_t value = points[i].x;
+                        const auto r = lower_bound(repeated.begin(), repeated.end(), value);
+                        if (r != repeated.end() && *r == value)
+                        {
+                            const size_t k = static_cast<size_t>(r - repeated.begin());
+                            if (seen[k] || binary_search(sortedX.begin(), prefix, value))
+                                continue;
+                            seen[k] = true;
+                        }
+                        points[kept++] = points[i];
+                    }
+                    points.erase(points.begin() + kept, points.end());
+
+                    auto last = unique(prefix, sortedX.end());
+                    last = remove_if(prefix, last, [&](domain_t value) { return binary_search(sortedX.begin(), prefix, value); });
+                    sortedX.erase(last, sortedX.end());
+                }
+
+                inplace_merge(sortedX.begin(), sortedX.begin() + start, sortedX.end());
+            }
+            return points.size() - start;
+        }
+
+        // Discards the points appended since `start`.
+        void rollback(std::size_t start)
+        {
+            points.erase(points.begin() + start, points.end());
+            if (indexed)
+                sortedX.resize(start);
+        }
+
+        void sortedPoints(std::vector<domain_t>& xs, std::vector<range_t>& ys) const
+        {
+            // Copies the points into separate lists in increasing order of x.
+            const std::size_t n = points.size();
+            std::vector<std::size_t> order(n);
+            for (std::size_t i = 0; i < n; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+            {
+                return points[a].x < points[b].x;
+            });
+            xs.resize(n);
+            ys.resize(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                xs[i] = points[order[i]].x;
+                ys[i] = points[order[i]].y;
+            }
+        }
+
+        static PiecewisePolynomial<domain_t, range_t> cubicHermite(
+            const std::vector<domain_t>& xs,
+            const std::vector<range_t>& ys,
+            const std::vector<range_t>& slopes)
+        {
+            // Packs the cubic segments that match the given values and slopes at both ends.
+            const std::size_t n = xs.size();
+            const domain_t two = 2;
+            const domain_t three = 3;
+            std::vector<range_t> table(4*(n-1));
+            for (std::size_t i = 0; i+1 < n; ++i)
+            {
+                const domain_t h = xs[i+1] - xs[i];
+                const range_t delta = (ys[i+1] - ys[i]) / h;
+                table[4*i + 0] = ys[i];
+                table[4*i + 1] = slopes[i];
+                table[4*i + 2] = (three*delta - two*slopes[i] - slopes[i+1]) / h;
+                table[4*i + 3] = (slopes[i] + slopes[i+1] - two*delta) / (h*h);
+            }
+            return PiecewisePolynomial<domain_t, range_t>{xs, 4, table};
+        }
+
+        Polynomial<domain_t, range_t> term(std::size_t j) const
+        {
+            // Returns y_j times the product of (x - x_k)/(x_j - x_k) for all k != j.
+            using namespace std;
+            const size_t n = points.size();
+            Polynomial<domain_t, range_t> fraction { 1 };
+            for (size_t k = 0; k < n; ++k)
+            {
+                if (k != j)
+                {
+                    // fraction *= (x - x_k)/(x_j - x_k)
+                    domain_t denom = points[j].x - points[k].x;
+                    fraction *= Polynomial<domain_t, range_t>{-points[k].x / denom, 1 / denom};
+                }
+            }
+            return points[j].y * fraction;
+        }
+
+    public:
+        /// @brief Empties the collection of points inside this interpolator.
+        void clear()
+        {
+            points.clear();
+            sortedX.clear();
+            indexed = false;
+        }
+
+        /// @brief Reserves storage for a total number of points, to avoid reallocation while inserting.
+        /// @param capacity The number of points expected.
+        void reserve(std::size_t capacity)
+        {
+            points.reserve(capacity);
+            if (indexed)
+                sortedX.reserve(capacity);
+        }
+
+        /// @brief Inserts another point `(x, y)` to this interpolator.
+        /// @remarks
+        /// A successful call that inserts a new point will return `true`.
+        /// An interpolator requires a unique value for all `x` values supplied.
+        /// If an `x` value has already been defined by a call to `insert`,
+        /// and the same `x` value is passed again by later call(s) to `insert`,
+        /// the later call(s) will have no effect and return `false`.
+        /// Checking for a duplicate takes O(n) time. Once points have been inserted in bulk,
+        /// a real-valued interpolator keeps a sorted copy of its x values; a duplicate is then
+        /// found in O(log n) comparisons, but placing the new value still moves O(n) elements.
+        /// To insert many points, use the array overload of `insert`.
+        /// Throws `std::invalid_argument` if a real-valued `x` is NaN.
+        /// @param x The value of the independent variable `x` for this point.
+        /// @param y The value of the depdendent variable `y` for this point.
+        /// @return If successful, `true`; otherwise `false`. See remarks.
+        bool insert(domain_t x, range_t y)
+        {
+            // The x value must never appear more than once,
+            // otherwise there can be inconsistent y values for the same x.
+            // Even if the y values are the same, a duplicate would cause
+            // division by zero later.
+            if constexpr (ordered)
+                rejectNaN(x);
+
+            if (ordered && indexed)
+            {
+                auto position = std::lower_bound(sortedX.begin(), sortedX.end(), x);
+                if (position != sortedX.end() && *position == x)
+                    return false;
+                sortedX.insert(position, x);
+            }
+            else
+            {
+                for (const point_t& p : points)
+                    if (p.x == x)
+                        return false;
+            }
+
+            points.push_back(point_t{x, y});
+            return true;
+        }
+
+        /// @brief Inserts an array of points `(x[i], y[i])` to this interpolator.
+        /// @remarks
+        /// Has the same effect as calling `insert(x[i], y[i])` for each point in turn,
+        /// including skipping any point whose `x` value has already been inserted.
+        /// For real-valued `x`, the cost is O(count*log(n)) plus one linear merge,
+        /// instead of a search of all existing points for every new point.
+        /// The first bulk insertion also builds a sorted copy of the existing x values,
+        /// in O(n*log(n)), which is kept for later insertions.
+        /// Throws `std::invalid_argument` if any real-valued `x[i]` is NaN,
+        /// in which case no points are inserted.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` values of the dependent variable.
+        /// @param count The number of points in the arrays.
+        /// @return The number of points that were inserted.
+        std::size_t insert(const domain_t* x, const range_t* y, std::size_t count)
+        {
+            const std::size_t start = points.size();
+            append(x, y, count);
+            return commit(start);
+        }
+
+        /// @brief Returns the number of points inserted into this interpolator.
+        std::size_t size() const
+        {
+            return points.size();
+        }
+
+        /// @brief Returns one of the inserted points, in the order they were inserted.
+        /// @param index A value in the range `0` to `size()-1`.
+        /// @return The pair `(x, y)` for the point.
+        std::pair<domain_t, range_t> point(std::size_t index) const
+        {
+            const point_t& p = points.at(index);
+            return std::make_pair(p.x, p.y);
+        }
+
+        /// @brief Calculates the unique polynomial that passes through the supplied points.
+        /// @return A polynomial whose value passes through all inserted points.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            using namespace std;
+            const size_t n = points.size();
+
+            Polynomial<domain_t, range_t> sum;
+            for (size_t j = 0; j < n; ++j)
+                sum += term(j);
+
+            return sum;
+        }
+
+        /// @brief Calculates the interpolating polynomial using multiple threads.
+        /// @remarks
+        /// Each point contributes an independent term to the polynomial.
+        /// The terms are divided among threads, each thread accumulates a partial sum,
+        /// and the partial sums are added pairwise in a tree.
+        /// When `options.deterministic` is `true`, the points are grouped into fixed
+        /// blocks whose partial sums are combined in a fixed order, so the result
+        /// is bit-for-bit reproducible no matter how many threads are used.
+        /// @param options Specifies the number of threads and whether the result must be reproducible.
+        /// @return A polynomial whose value passes through all inserted points.
+        Polynomial<domain_t, range_t> polynomial(const ParallelOptions& options) const
+        {
+            using namespace std;
+            using poly_t = Polynomial<domain_t, range_t>;
+
+            const size_t n = points.size();
+            const unsigned threads = static_cast<unsigned>(min<size_t>(options.resolvedThreadCount(), max<size_t>(n, 1)));
+            atomic<size_t> next{0};
+
+            if (options.deterministic)
+            {
+                const size_t nblocks = (n + deterministicBlockSize - 1) / deterministicBlockSize;
+                vector<poly_t> partial(nblocks);
+                auto work = [&](unsigned)
+                {
+                    for (size_t b; (b = next++) < nblocks; )
+                    {
+                        const size_t stop = min(n, (b+1)*deterministicBlockSize);
+                        for (size_t j = b*deterministicBlockSize; j < stop; ++j)
+                            partial[b] += term(j);
+                    }
+                };
+                Internal::runThreads(threads, work);
+                return Internal::treeSum(partial);
+            }
+
+            vector<poly_t> partial(threads);
+            auto work = [&](unsigned index)
+            {
+                for (size_t j; (j = next++) < n; )
+                    partial[index] += term(j);
+            };
+            Internal::runThreads(threads, work);
+            return Internal::treeSum(partial);
+        }
+
+        /// @brief Calculates a piecewise polynomial by local interpolation over windows of neighboring points.
+        /// @remarks
+        /// The points are sorted by x and become the breakpoints of the result.
+        /// Each segment between neighboring points is the polynomial that passes through
+        /// the `windowSize` points nearest that segment, so the segments have degree `windowSize-1`.
+        /// For example, `windowSize` = 4 produces local cubic interpolation.
+        /// Unlike #polynomial, this remains accurate and fast to evaluate for any number of points.
+        /// Requires a real-like `domain_t`. Throws `std::invalid_argument` if there are fewer than 2 points,
+        /// or if `windowSize` is less than 2 or greater than the number of points.
+        /// @param windowSize The number of points used to calculate each segment.
+        /// @return A piecewise polynomial that passes through all inserted points.
+        PiecewisePolynomial<domain_t, range_t> piecewise(std::size_t windowSize) const
+        {
+            using namespace std;
+
+            const size_t n = points.size();
+            if (n < 2)
+                throw invalid_argument("Piecewise interpolation requires at least 2 points.");
+
+            if (windowSize < 2 || windowSize > n)
+                throw invalid_argument("Piecewise interpolation window size must be between 2 and the number of points.");
+
+            vector<domain_t> breaks;
+            vector<range_t> values;
+            sortedPoints(breaks, values);
+
+            vector<range_t> table((n-1) * windowSize);
+            const size_t before = (windowSize - 2) / 2;
+            for (size_t s = 0; s+1 < n; ++s)
+            {
+                // Center the window on the segment, sliding it inward near either end.
+                const size_t start = min((s > before) ? (s - before) : 0, n - windowSize);
+                Interpolator local;
+                for (size_t i = start; i < start + windowSize; ++i)
+                    local.insert(breaks[i] - breaks[s], values[i]);
+
+                const Polynomial<domain_t, range_t> poly = local.polynomial();
+                const vector<range_t>& c = poly.coefficients();
+                copy(c.begin(), c.end(), table.begin() + s*windowSize);
+            }
+
+            return PiecewisePolynomial<domain_t, range_t>{breaks, windowSize, table};
+        }
+
+        /// @brief Calculates the natural cubic spline that passes through the supplied points.
+        /// @remarks
+        /// The spline has continuous first and second derivatives, and its second derivative
+        /// is zero at both ends. The tridiagonal system for the second derivatives at the points
+        /// is solved in linear time. The result packs 4 coefficients per segment,
+        /// so each evaluation is a single cubic Horner step after the segment lookup.
+        /// Requires a real-like `domain_t`. Throws `std::invalid_argument` if there are fewer than 2 points.
+        /// @return A piecewise cubic polynomial that passes through all inserted points.
+        PiecewisePolynomial<domain_t, range_t> naturalSpline() const
+        {
+            using namespace std;
+
+            const size_t n = points.size();
+            if (n < 2)
+                throw invalid_argument("Spline interpolation requires at least 2 points.");
+
+            vector<domain_t> xs;
+            vector<range_t> ys;
+            sortedPoints(xs, ys);
+
+            // Solve for the second derivatives m[i] with m[0] = m[n-1] = 0, using the Thomas algorithm:
+            // h[i-1]*m[i-1] + 2*(h[i-1] + h[i])*m[i] + h[i]*m[i+1] = 6*(delta[i] - delta[i-1]).
+            const domain_t two = 2;
+            const domain_t six = 6;
+            vector<range_t> m(n);
+            vector<domain_t> upper(n);
+            for (size_t i = 1; i+1 < n; ++i)
+            {
+                const domain_t h0 = xs[i] - xs[i-1];
+                const domain_t h1 = xs[i+1] - xs[i];
+                const range_t rhs = six*((ys[i+1] - ys[i])/h1 - (ys[i] - ys[i-1])/h0);
+                const domain_t pivot = two*(h0 + h1) - h0*upper[i-1];
+                upper[i] = h1 / pivot;
+                m[i] = (rhs - h0*m[i-1]) / pivot;
+            }
+            for (size_t i = n-2; i > 0; --i)
+                m[i] -= upper[i] * m[i+1];
+
+            // Convert second derivatives to slopes, then reuse the Hermite packing.
+            vector<range_t> slopes(n);
+            for (size_t i = 0; i+1 < n; ++i)
+            {
+                const domain_t h = xs[i+1] - xs[i];
+                slopes[i] = (ys[i+1] - ys[i])/h - h*(two*m[i] + m[i+1])/six;
+            }
+            const domain_t hlast = xs[n-1] - xs[n-2];
+            slopes[n-1] = (ys[n-1] - ys[n-2])/hlast + hlast*(m[n-2] + two*m[n-1])/six;
+            return cubicHermite(xs, ys, slopes);
+        }
+
+        /// @brief Calculates a monotone cubic spline that passes through the supplied points.
+        /// @remarks
+        /// Uses the PCHIP slopes of Fritsch and Butland, a weighted harmonic mean of the neighboring
+        /// secants: the spline is increasing wherever the data are increasing,
+        /// decreasing wherever they are decreasing, and never overshoots the data.
+        /// It has a continuous first derivative. The result packs 4 coefficients per segment.
+        /// Requires real-like `domain_t` and `range_t`.
+        /// Throws `std::invalid_argument` if there are fewer than 2 points.
+        /// @return A piecewise cubic polynomial that passes through all inserted points.
+        PiecewisePolynomial<domain_t, range_t> monotoneSpline() const
+        {
+            using namespace std;
+
+            const size_t n = points.size();
+            if (n < 2)
+                throw invalid_argument("Spline interpolation requires at least 2 points.");
+
+            vector<domain_t> xs;
+            vector<range_t> ys;
+            sortedPoints(xs, ys);
+
+            vector<domain_t> h(n-1);
+            vector<range_t> delta(n-1);
+            for (size_t i = 0; i+1 < n; ++i)
+            {
+                h[i] = xs[i+1] - xs[i];
+                delta[i] = (ys[i+1] - ys[i]) / h[i];
+            }
+
+            const range_t zero = 0;
+            vector<range_t> slopes(n);
+            if (n == 2)
+            {
+                slopes[0] = slopes[1] = delta[0];
+                return cubicHermite(xs, ys, slopes);
+            }
+
+            // Interior slopes: a weighted harmonic mean of the neighboring secants,
+            // or zero at a local extremum of the data.
+            for (size_t i = 1; i+1 < n; ++i)
+            {
+                if (delta[i-1]*delta[i] <= zero)
+                    slopes[i] = zero;
+                else
+                {
+                    const domain_t w1 = 2*h[i] + h[i-1];
+                    const domain_t w2 = h[i] + 2*h[i-1];
+                    slopes[i] = (w1 + w2) / (w1/delta[i-1] + w2/delta[i]);
+                }
+            }
+
+            // End slopes: a one-sided three-point estimate, limited to preserve monotonicity.
+            auto endSlope = [zero](domain_t h0, domain_t h1, range_t d0, range_t d1) -> range_t
+            {
+                const range_t slope = ((2*h0 + h1)*d0 - h0*d1) / (h0 + h1);
+                if (slope*d0 <= zero)
+                    return zero;
+                if (d0*d1 <= zero && abs(slope) > abs(3*d0))
+                    return 3*d0;
+                return slope;
+            };
+            slopes[0] = endSlope(h[0], h[1], delta[0], delta[1]);
+            slopes[n-1] = endSlope(h[n-2], h[n-3], delta[n-2], delta[n-3]);
+            return cubicHermite(xs, ys, slopes);
+        }
+    };
+
+
+    /// @brief Interpolates values given at equally spaced points `x_i = x0 + i*h`.
+    /// @remarks
+    /// For equally spaced points, the barycentric weights have the closed form
+    /// `w_i = (-1)^(n-1-i) / (i! * (n-1-i)!)`, so they are found in O(n) operations
+    /// instead of the O(n^2) subtractions and divisions of a general `Interpolator`.
+    /// The barycentric formula does not change when all weights are scaled by a common factor,
+    /// so the stored weights drop the factor `(-1)^(n-1)/(n-1)!`, leaving `(-1)^i * C(n-1, i)`,
+    /// and are divided by the largest binomial coefficient so they cannot overflow.
+    /// Evaluation through the barycentric formula then costs O(n) per value of x,
+    /// and #polynomial builds the explicit polynomial in O(n^2) multiply-adds.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the dependent variable `y`.
+    template<typename domain_t, typename range_t>
+    class UniformInterpolator
+    {
+    private:
+        domain_t origin;
+        domain_t spacing;
+        std::vector<range_t> values;
+        std::vector<domain_t> weights;
+
+    public:
+        /// @brief Creates an interpolator for equally spaced points.
+        /// @remarks
+        /// Throws `std::invalid_argument` if `h` is zero.
+        /// @param x0 The value of x for the first point.
+        /// @param h The spacing between consecutive values of x.
+        /// @param ys The values of y at `x0`, `x0 + h`, `x0 + 2*h`, and so on.
+        UniformInterpolator(domain_t x0, domain_t h, const std::vector<range_t>& ys)
+            : origin(x0)
+            , spacing(h)
+            , values(ys)
+            , weights(ys.size())
+        {
+            if (h == domain_t{0})
+                throw std::invalid_argument("UniformInterpolator spacing must be nonzero.");
+
+            // w[j] = (-1)^j * C(n-1, j) / C(n-1, m), where C(n-1, m) is the central (largest)
+            // binomial coefficient. Start from |w[m]| = 1 and work outward, so the
+            // magnitudes only ever decrease.
+            const std::size_t n = values.size();
+            if (n == 0)
+                return;
+            const std::size_t m = (n-1) / 2;
+            weights[m] = (m % 2 == 0) ? 1 : -1;
+            for (std::size_t j = m; j > 0; --j)
+                weights[j-1] = -weights[j] * static_cast<domain_t>(j) / static_cast<domain_t>(n-j);
+            for (std::size_t j = m; j+1 < n; ++j)
+                weights[j+1] = -weights[j] * static_cast<domain_t>(n-1-j) / static_cast<domain_t>(j+1);
+        }
+
+        /// @brief Returns the number of points.
+        std::size_t size() const
+        {
+            return values.size();
+        }
+
+        /// @brief Evaluates the interpolating polynomial for a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The value of the polynomial that passes through all the points, or zero if there are none.
+        range_t operator() (domain_t x) const
+        {
+            const std::size_t n = values.size();
+            if (n == 0)
+                return 0;
+
+            const domain_t s = (x - origin) / spacing;
+            range_t numer = 0;
+            domain_t denom = 0;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                const domain_t diff = s - static_cast<domain_t>(j);
+                if (diff == domain_t{0})
+                    return values[j];
+                const domain_t t = weights[j] / diff;
+                numer += t * values[j];
+                denom += t;
+            }
+            return numer / denom;
+        }
+
+        /// @brief Calculates the unique polynomial that passes through the points.
+        /// @return A polynomial whose value passes through all the points.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            using namespace std;
+
+            const size_t n = values.size();
+            if (n == 0)
+                return Polynomial<domain_t, range_t>{};
+
+            // Work in the local variable s = (x - c)/h, where c is the center of the points.
+            // The points are then symmetric about s = 0, at s = j - (n-1)/2, which keeps
+            // the intermediate coefficients small. Find the node polynomial l(s) = product of (s - s_j).
+            // The stored weights lack the factor (-1)^(n-1) / (m! * (n-1-m)!), which is put back
+            // here by dividing the factors for k = 1, 2, ..., n-1 by 1, 1, 2, 2, 3, 3, ...
+            // in turn, so that l(s) stays well scaled as it grows.
+            const domain_t half = static_cast<domain_t>(n-1) / 2;
+            vector<domain_t> node(n+1);
+            node[0] = 1;
+            for (size_t k = 0; k < n; ++k)
+            {
+                const domain_t root = static_cast<domain_t>(k) - half;
+                node[k+1] = node[k];
+                for (size_t i = k; i > 0; --i)
+                    node[i] = node[i-1] - root*node[i];
+                node[0] = -root*node[0];
+                if (k > 1)
+                {
+                    const domain_t divisor = static_cast<domain_t>((k+1) / 2);
+                    for (size_t i = 0; i <= k+1; ++i)
+                        node[i] /= divisor;
+                }
+            }
+
+            // The Lagrange basis polynomial for point j is w_j * l(s)/(s - s_j).
+            // Divide out each root by synthetic division, which needs no divisions at all.
+            const domain_t sign = ((n-1) % 2 == 0) ? 1 : -1;
+            vector<range_t> local(n);
+            for (size_t j = 0; j < n; ++j)
+            {
+                const domain_t root = static_cast<domain_t>(j) - half;
+                const range_t scale = (sign * weights[j]) * values[j];
+                domain_t carry = node[n];
+                for (size_t i = n; i > 0; --i)
+                {
+                    local[i-1] += carry * scale;
+                    carry = node[i-1] + root*carry;
+                }
+            }
+
+            // Substitute s = a + b*x.
+            const domain_t b = 1 / spacing;
+            const domain_t a = -(origin + half*spacing) * b;
+            return Polynomial<domain_t, range_t>{Internal::substituteLinear(local, a, b)};
+        }
+    };
+
+
+    /// @brief Interpolates the most recent points of a stream, such as live sensor samples.
+    /// @remarks
+    /// Holds at most `windowSize` points in a ring buffer allocated once by the constructor.
+    /// Each call to #push drops the oldest point when the window is full and adds the newest,
+    /// updating the barycentric weights of the interpolating polynomial in O(windowSize) operations.
+    /// Because the incremental updates accumulate rounding error, each push also recomputes
+    /// one weight from scratch, cycling through the ring buffer, so every weight is refreshed
+    /// at least once per `windowSize` pushes while every push costs the same O(windowSize).
+    /// Evaluation uses the barycentric formula, which always performs the same
+    /// O(windowSize) operations, giving fixed latency suitable for a real-time loop.
+    /// Neither #push nor evaluation allocates memory.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the dependent variable `y`.
+    template<typename domain_t, typename range_t>
+    class StreamingInterpolator
+    {
+    private:
+        std::vector<domain_t> xs;
+        std::vector<range_t> ys;
+        std::vector<domain_t> weights;
+        std::size_t head;       // the slot holding the oldest point
+        std::size_t count;      // the number of points in the window
+        std::size_t refresh;    // the next slot whose weight is recomputed from scratch
+
+        void recomputeWeight(std::size_t j)
+        {
+            // w_j = 1 / product of (x_j - x_m) over the other points in the window.
+            const std::size_t k = xs.size();
+            domain_t product = 1;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t m = (head + i) % k;
+                if (m != j)
+                    product *= xs[j] - xs[m];
+            }
+            weights[j] = 1 / product;
+        }
+
+    public:
+        /// @brief Creates an empty streaming interpolator.
+        /// @param windowSize
+        /// The maximum number of recent points to interpolate.
+        /// The polynomial has degree `windowSize-1` once the window is full.
+        /// Throws `std::invalid_argument` if zero.
+        explicit StreamingInterpolator(std::size_t windowSize)
+            : xs(windowSize)
+            , ys(windowSize)
+            , weights(windowSize)
+            , head(0)
+            , count(0)
+            , refresh(0)
+        {
+            if (windowSize == 0)
+                throw std::invalid_argument("StreamingInterpolator window size must be positive.");
+        }
+
+        /// @brief Returns the maximum number of points in the window.
+        std::size_t windowSize() const
+        {
+            return xs.size();
+        }
+
+        /// @brief Returns the number of points currently in the window.
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /// @brief Indicates whether the window holds its maximum number of points.
+        bool full() const
+        {
+            return count == xs.size();
+        }
+
+        /// @brief Removes all points from the window.
+        void clear()
+        {
+            head = 0;
+            count = 0;
+            refresh = 0;
+        }
+
+        /// @brief Adds a new point, dropping the oldest point if the window is full.
+        /// @remarks
+        /// As with `Interpolator::insert`, the x values in the window must be unique.
+        /// If `x` matches another point that would remain in the window,
+        /// the call has no effect and returns `false`.
+        /// @param x The value of the independent variable `x` for this point.
+        /// @param y The value of the dependent variable `y` for this point.
+        /// @return If successful, `true`; otherwise `false`. See remarks.
+        bool push(domain_t x, range_t y)
+        {
+            const std::size_t k = xs.size();
+            const std::size_t first = full() ? 1 : 0;   // skip the oldest point if it is about to be dropped
+            for (std::size_t i = first; i < count; ++i)
+                if (xs[(head + i) % k] == x)
+                    return false;
+
+            if (full())
+            {
+                // Remove the factor 1/(x_j - x_oldest) from each remaining weight.
+                const domain_t oldest = xs[head];
+                head = (head + 1) % k;
+                --count;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const std::size_t j = (head + i) % k;
+                    weights[j] *= (xs[j] - oldest);
+                }
+            }
+
+            // Include the factor 1/(x_j - x) in each existing weight, and find the new point's weight.
+            domain_t product = 1;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t j = (head + i) % k;
+                const domain_t diff = xs[j] - x;
+                weights[j] /= diff;
+                product *= -diff;
+            }
+
+            const std::size_t slot = (head + count) % k;
+            xs[slot] = x;
+            ys[slot] = y;
+            weights[slot] = 1 / product;
+            ++count;
+
+            // Discard the accumulated rounding error of one weight per push.
+            // Each point stays in the same slot for its whole life in the window,
+            // so cycling through the slots refreshes it within `windowSize` pushes.
+            const std::size_t j = refresh;
+            refresh = (refresh + 1) % k;
+            if ((j + k - head) % k < count)
+                recomputeWeight(j);
+            return true;
+        }
+
+        /// @brief Evaluates the polynomial that passes through the points in the window.
+        /// @param x The value of the independent variable.
+        /// @return The value of the interpolating polynomial at x, or zero if the window is empty.
+        range_t operator() (domain_t x) const
+        {
+            // Second (true) form of the barycentric formula:
+            // f(x) = sum(w_j*y_j/(x - x_j)) / sum(w_j/(x - x_j)).
+            if (count == 0)
+                return 0;
+
+            range_t numer = 0;
+            domain_t denom = 0;
+            const range_t* exact = nullptr;
+            const std::size_t k = xs.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t j = (head + i) % k;
+                const domain_t diff = x - xs[j];
+                if (diff == domain_t{0})
+                {
+                    // The formula is indeterminate at a point in the window.
+                    exact = &ys[j];
+                    continue;
+                }
+                const domain_t t = weights[j] / diff;
+                numer += t * ys[j];
+                denom += t;
+            }
+
+            if (exact)
+                return *exact;
+
+            return numer / denom;
+        }
+
+        /// @brief Calculates the polynomial that passes through the points in the window.
+        /// @return A new polynomial whose value passes through all points in the window.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            Interpolator<domain_t, range_t> interp;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t j = (head + i) % xs.size();
+                interp.insert(xs[j], ys[j]);
+            }
+            return interp.polynomial();
+        }
+    };
+
+
+    /// @brief Converts a stream of samples from one sample rate to another using Lagrange interpolation.
+    /// @remarks
+    /// Each output sample is interpolated from the `order+1` input samples surrounding it,
+    /// using the Lagrange basis polynomials for equally spaced taps.
+    /// Instead of constructing a polynomial per output sample, the constructor precomputes
+    /// a polyphase table holding the tap coefficients for `phases` evenly spaced fractional
+    /// delays between neighboring input samples. Each output sample then costs one table lookup
+    /// and a short dot product, written with independent accumulator lanes so the compiler
+    /// can vectorize it without reordering floating point sums.
+    /// Input is supplied in blocks with #push and output is retrieved in blocks with #pull.
+    /// All memory is allocated by the constructor; no per-sample allocation occurs.
+    /// The first output sample is aligned with the first input sample.
+    /// @tparam sample_t The floating point type of the audio samples.
+    template<typename sample_t = float>
+    class LagrangeResampler
+    {
+    private:
+        using buffer_t = std::vector<sample_t, AlignedAllocator<sample_t>>;
+
+        static constexpr std::size_t lanes = 4;
+
+        std::size_t tapCount;
+        std::size_t phaseCount;
+        std::size_t rowStride;
+        std::size_t history;     // the number of taps before the interpolation point
+        double step;             // input samples per output sample
+        buffer_t table;
+        buffer_t buffer;
+        std::size_t fill;
+        double position;         // the location of the next output sample within `buffer`
+
+        void compact()
+        {
+            // Discard input samples that no future output sample will use.
+            const std::size_t used = static_cast<std::size_t>(position);
+            if (used <= history)
+                return;
+            const std::size_t drop = std::min(used - history, fill);
+            std::copy(buffer.begin() + drop, buffer.begin() + fill, buffer.begin());
+            fill -= drop;
+            position -= static_cast<double>(drop);
+        }
+
+    public:
+        /// @brief Creates a resampler.
+        /// @remarks
+        /// Throws `std::invalid_argument` if either rate is not positive, `order` or `phases` is zero,
+        /// or `capacity` is smaller than the number of taps.
+        /// @param inputRate The sample rate of the input stream.
+        /// @param outputRate The sample rate of the output stream.
+        /// @param order The degree of the interpolating polynomials. The number of taps is `order+1`.
+        /// @param phases The number of fractional delays in the polyphase table.
+        /// @param capacity The maximum number of input samples buffered between calls to #pull.
+        LagrangeResampler(
+            double inputRate,
+            double outputRate,
+            std::size_t order = 3,
+            std::size_t phases = 256,
+            std::size_t capacity = 4096)
+            : tapCount(order + 1)
+            , phaseCount(phases)
+            , rowStride(((order + lanes) / lanes) * lanes)
+            , history(order / 2)
+            , step(inputRate / outputRate)
+            , fill(0)
+            , position(0)
+        {
+            using namespace std;
+
+            if (!(inputRate > 0) || !(outputRate > 0))
+                throw invalid_argument("LagrangeResampler sample rates must be positive.");
+
+            if (order == 0 || phases == 0)
+                throw invalid_argument("LagrangeResampler order and phase count must be positive.");
+
+            if (capacity < tapCount)
+                throw invalid_argument("LagrangeResampler capacity must be at least the number of taps.");
+
+            // Row p holds the tap weights for the fractional delay p/phases.
+            // An extra row for delay 1 avoids a special case when rounding to the nearest phase.
+            // The taps sit at positions -history, ..., 0, ..., order-history relative to the
+            // input sample just before the output sample, and the weight of each tap is
+            // its Lagrange basis polynomial evaluated at the fractional delay.
+            table.assign((phaseCount + 1) * rowStride, 0);
+            for (size_t k = 0; k < tapCount; ++k)
+            {
+                Interpolator<double, double> interp;
+                for (size_t j = 0; j < tapCount; ++j)
+                    interp.insert(static_cast<double>(j) - static_cast<double>(history), (j == k) ? 1.0 : 0.0);
+                const Polynomial<double, double> basis = interp.polynomial();
+                for (size_t p = 0; p <= phaseCount; ++p)
+                    table[p*rowStride + k] = static_cast<sample_t>(basis(static_cast<double>(p) / phaseCount));
+            }
+
+            buffer.resize(capacity + history);
+            reset();
+        }
+
+        /// @brief Returns the number of input samples used to calculate each output sample.
+        std::size_t taps() const
+        {
+            return tapCount;
+        }
+
+        /// @brief Returns the number of fractional delays in the polyphase table.
+        std::size_t phases() const
+        {
+            return phaseCount;
+        }
+
+        /// @brief Returns the number of input samples consumed per output sample.
+        double ratio() const
+        {
+            return step;
+        }
+
+        /// @brief Discards all buffered input and restarts the stream.
+        void reset()
+        {
+            // Begin with silence before the first input sample.
+            std::fill(buffer.begin(), buffer.begin() + history, sample_t{0});
+            fill = history;
+            position = static_cast<double>(history);
+        }
+
+        /// @brief Appends a block of input samples.
+        /// @remarks
+        /// The internal buffer has a fixed capacity. If it cannot hold all of the samples,
+        /// only the leading samples that fit are accepted; call #pull to make room for the rest.
+        /// @param input An array of input samples.
+        /// @param count The number of samples in the array.
+        /// @return The number of samples accepted.
+        std::size_t push(const sample_t* input, std::size_t count)
+        {
+            if (fill + count > buffer.size())
+                compact();
+            const std::size_t accepted = std::min(count, buffer.size() - fill);
+            std::copy(input, input + accepted, buffer.begin() + fill);
+            fill += accepted;
+            return accepted;
+        }
+
+        /// @brief Produces as many output samples as the buffered input allows.
+        /// @param output An array that receives output samples.
+        /// @param maxCount The maximum number of samples to write to the array.
+        /// @return The number of samples written.
+        std::size_t pull(sample_t* output, std::size_t maxCount)
+        {
+            std::size_t produced = 0;
+            while (produced < maxCount)
+            {
+                const std::size_t n = static_cast<std::size_t>(position);
+                if (n - history + tapCount > fill)
+                    break;
+
+                const double mu = position - static_cast<double>(n);
+                const std::size_t p = static_cast<std::size_t>(mu*phaseCount + 0.5);
+                const sample_t* row = table.data() + p*rowStride;
+                const sample_t* src = buffer.data() + (n - history);
+
+                sample_t acc[lanes] = {};
+                std::size_t k = 0;
+                for (; k + lanes <= tapCount; k += lanes)
+                    for (std::size_t lane = 0; lane < lanes; ++lane)
+                        acc[lane] += row[k + lane] * src[k + lane];
+                for (std::size_t lane = 0; k < tapCount; ++k, ++lane)
+                    acc[lane] += row[k] * src[k];
+
+                sample_t sum = 0;
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    sum += acc[lane];
+                output[produced++] = sum;
+                position += step;
+            }
+            compact();
+            return produced;
+        }
+    };
+
+
+    /// @brief A polynomial whose value is a fixed-size array of channels, such as the coordinates of a trajectory.
+    /// @remarks
+    /// Equivalent to `channels` separate polynomials of the same `x`, but the coefficients
+    /// are stored channel-contiguous for each power of `x`, so that one Horner pass over `x`
+    /// updates all channels together, and the inner loop over channels can be vectorized.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of each channel's value.
+    /// @tparam channels The number of channels.
+    template<typename domain_t, typename range_t, std::size_t channels>
+    class MultiChannelPolynomial
+    {
+    public:
+        static_assert(channels > 0, "MultiChannelPolynomial requires at least one channel.");
+
+        /// @brief The type of one value for all channels.
+        using value_t = std::array<range_t, channels>;
+
+        /// @brief The container type for the coefficient table.
+        using table_t = std::vector<range_t, AlignedAllocator<range_t>>;
+
+    private:
+        table_t coeff;      // coeff[power*channels + channel]
+
+        void truncate()
+        {
+            // Remove trailing powers whose coefficients are zero in every channel.
+            std::size_t n = coeff.size() / channels;
+            while (n > 0)
+            {
+                const range_t* c = coeff.data() + (n-1)*channels;
+                bool zero = true;
+                for (std::size_t ch = 0; ch < channels && zero; ++ch)
+                    zero = (c[ch] == range_t{0});
+                if (!zero)
+                    break;
+                --n;
+            }
+            coeff.resize(n * channels);
+        }
+
+    public:
+        /// @brief Creates the zero polynomial.
+        MultiChannelPolynomial() {}
+
+        /// @brief Creates a polynomial from one array of channel values for each power of `x`.
+        /// @param coefficients The coefficients in increasing order of power of `x`.
+        explicit MultiChannelPolynomial(const std::vector<value_t>& coefficients)
+        {
+            coeff.reserve(coefficients.size() * channels);
+            for (const value_t& c : coefficients)
+                coeff.insert(coeff.end(), c.begin(), c.end());
+            truncate();
+        }
+
+        /// @brief Creates a polynomial from a separate polynomial for each channel.
+        /// @param polynomials The polynomial for each channel.
+        explicit MultiChannelPolynomial(const std::array<Polynomial<domain_t, range_t>, channels>& polynomials)
+        {
+            std::size_t n = 0;
+            for (const Polynomial<domain_t, range_t>& poly : polynomials)
+                n = std::max(n, poly.coefficients().size());
+            coeff.assign(n * channels, range_t{0});
+            for (std::size_t ch = 0; ch < channels; ++ch)
+            {
+                const std::vector<range_t>& c = polynomials[ch].coefficients();
+                for (std::size_t k = 0; k < c.size(); ++k)
+                    coeff[k*channels + ch] = c[k];
+            }
+        }
+
+        /// @brief Returns the number of powers of `x` stored, which is one more than the degree, or zero for the zero polynomial.
+        std::size_t powerCount() const
+        {
+            return coeff.size() / channels;
+        }
+
+        /// @brief Returns the coefficient table, with all channels for power 0, then all channels for power 1, and so on.
+        const table_t& coefficients() const
+        {
+            return coeff;
+        }
+
+        /// @brief Returns the coefficients of every channel for one power of `x`.
+        /// @param power The power of `x`, in the range `0` to `powerCount()-1`.
+        value_t coefficient(std::size_t power) const
+        {
+            value_t c;
+            std::copy_n(coeff.begin() + power*channels, channels, c.begin());
+            return c;
+        }
+
+        /// @brief Returns the polynomial of a single channel.
+        /// @param ch The channel index, in the range `0` to `channels-1`.
+        Polynomial<domain_t, range_t> channel(std::size_t ch) const
+        {
+            const std::size_t n = powerCount();
+            std::vector<range_t> c(n);
+            for (std::size_t k = 0; k < n; ++k)
+                c[k] = coeff[k*channels + ch];
+            return Polynomial<domain_t, range_t>{c};
+        }
+
+        /// @brief Evaluates every channel at a given value of `x`.
+        /// @param x The value of the independent variable.
+        /// @return The value of each channel at `x`.
+        value_t operator() (domain_t x) const
+        {
+            value_t sum;
+            const std::size_t n = powerCount();
+            if (n == 0)
+            {
+                sum.fill(range_t{0});
+                return sum;
+            }
+            const range_t* c = coeff.data() + (n-1)*channels;
+            for (std::size_t ch = 0; ch < channels; ++ch)
+                sum[ch] = c[ch];
+            for (std::size_t k = n-1; k > 0; --k)
+            {
+                c -= channels;
+                for (std::size_t ch = 0; ch < channels; ++ch)
+                    sum[ch] = x*sum[ch] + c[ch];
+            }
+            return sum;
+        }
+
+        /// @brief Evaluates every channel for an array of x values.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the channel values.
+        /// @param count The number of values to evaluate.
+        void evaluate(const domain_t* x, value_t* y, std::size_t count) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = (*this)(x[i]);
+        }
+
+        /// @brief Returns the derivative of every channel with respect to `x`.
+        MultiChannelPolynomial derivative() const
+        {
+            MultiChannelPolynomial result;
+            const std::size_t n = powerCount();
+            if (n > 1)
+            {
+                result.coeff.resize((n-1) * channels);
+                for (std::size_t k = 1; k < n; ++k)
+                {
+                    const domain_t power = static_cast<domain_t>(k);
+                    for (std::size_t ch = 0; ch < channels; ++ch)
+                        result.coeff[(k-1)*channels + ch] = power * coeff[k*channels + ch];
+                }
+            }
+            return result;
+        }
+    };
+
+
+    /// @brief Derives a multi-channel polynomial that passes through points `(x, [y0, y1, ...])`.
+    /// @remarks
+    /// Works like `Interpolator`, but each point has a value for every channel.
+    /// The Lagrange basis polynomials depend only on the x values, so they are
+    /// calculated once and shared by all channels.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of each channel's value.
+    /// @tparam channels The number of channels.
+    template<typename domain_t, typename range_t, std::size_t channels>
+    class MultiChannelInterpolator
+    {
+    public:
+        /// @brief The type of one value for all channels.
+        using value_t = std::array<range_t, channels>;
+
+    private:
+        std::vector<domain_t> xs;
+        std::vector<value_t> ys;
+
+    public:
+        /// @brief Empties the collection of points inside this interpolator.
+        void clear()
+        {
+            xs.clear();
+            ys.clear();
+        }
+
+        /// @brief Returns the number of points inserted into this interpolator.
+        std::size_t size() const
+        {
+            return xs.size();
+        }
+
+        /// @brief Inserts another point `(x, y)` to this interpolator.
+        /// @remarks
+        /// As with `Interpolator::insert`, an `x` value that was already inserted
+        /// is ignored and the call returns `false`.
+        /// @param x The value of the independent variable `x` for this point.
+        /// @param y The value of every channel for this point.
+        /// @return If successful, `true`; otherwise `false`.
+        bool insert(domain_t x, const value_t& y)
+        {
+            for (const domain_t& existing : xs)
+                if (existing == x)
+                    return false;
+            xs.push_back(x);
+            ys.push_back(y);
+            return true;
+        }
+
+        /// @brief Calculates the polynomial that passes through the supplied points in every channel.
+        /// @return A multi-channel polynomial whose channels pass through all inserted points.
+        MultiChannelPolynomial<domain_t, range_t, channels> polynomial() const
+        {
+            using namespace std;
+            const size_t n = xs.size();
+            if (n == 0)
+                return MultiChannelPolynomial<domain_t, range_t, channels>{};
+
+            const vector<domain_t> basis = Internal::lagrangeBasis(xs);
+            vector<value_t> coeffs(n);
+            for (value_t& c : coeffs)
+                c.fill(range_t{0});
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (size_t p = 0; p < n; ++p)
+                {
+                    const domain_t b = basis[j*n + p];
+                    for (size_t ch = 0; ch < channels; ++ch)
+                        coeffs[p][ch] += b * ys[j][ch];
+                }
+            }
+            return MultiChannelPolynomial<domain_t, range_t, channels>{coeffs};
+        }
+    };
+
+
+    /// @brief Interpolates a function of several variables from its values on a rectangular grid.
+    /// @remarks
+    /// The result is the tensor product of one-dimensional Lagrange interpolation along each axis:
+    /// a polynomial in every coordinate that passes through every grid value.
+    /// The constructor converts the grid values into a contiguous tensor of monomial coefficients,
+    /// by applying each axis's basis polynomials along that axis once.
+    /// Each query then costs a nested Horner evaluation, O(n^dims) operations
+    /// for n nodes per axis, with no memory allocation.
+    /// As with `Interpolator`, high-degree polynomials are sensitive to rounding,
+    /// so grids should have modest numbers of nodes per axis.
+    /// @tparam domain_t The numeric type of each coordinate.
+    /// @tparam range_t The numeric type of the function values.
+    /// @tparam dims The number of coordinates, for example 2 for a surface `z = f(x, y)`.
+    template<typename domain_t, typename range_t, std::size_t dims>
+    class GridInterpolator
+    {
+    public:
+        static_assert(dims > 0, "GridInterpolator requires at least one dimension.");
+
+        /// @brief The type of one point in the domain.
+        using point_t = std::array<domain_t, dims>;
+
+    private:
+        std::array<std::vector<domain_t>, dims> nodes;
+        std::array<std::size_t, dims> shape;
+        std::array<std::size_t, dims> stride;
+        std::vector<range_t, AlignedAllocator<range_t>> coeff;
+
+        range_t evaluateAxis(std::size_t axis, const range_t* c, const point_t& x) const
+        {
+            const std::size_t n = shape[axis];
+            const domain_t t = x[axis];
+            if (axis+1 == dims)
+            {
+                range_t sum = c[n-1];
+                for (std::size_t p = n-1; p > 0; --p)
+                    sum = t*sum + c[p-1];
+                return sum;
+            }
+            const std::size_t s = stride[axis];
+            range_t sum = evaluateAxis(axis+1, c + (n-1)*s, x);
+            for (std::size_t p = n-1; p > 0; --p)
+                sum = t*sum + evaluateAxis(axis+1, c + (p-1)*s, x);
+            return sum;
+        }
+
+    public:
+        /// @brief Creates an interpolator from the grid nodes along each axis and the values at every node.
+        /// @remarks
+        /// Throws `std::invalid_argument` if an axis has no nodes or repeats a node,
+        /// or the number of values is not the product of the axis sizes.
+        /// @param axes The node coordinates along each axis.
+        /// @param values
+        /// The function value at every grid node, in row-major order:
+        /// the index along the last axis varies fastest.
+        GridInterpolator(const std::array<std::vector<domain_t>, dims>& axes, const std::vector<range_t>& values)
+            : nodes(axes)
+        {
+            using namespace std;
+            size_t total = 1;
+            for (size_t a = dims; a > 0; --a)
+            {
+                const vector<domain_t>& axis = nodes[a-1];
+                if (axis.empty())
+                    throw invalid_argument("GridInterpolator axis has no nodes.");
+                for (size_t i = 1; i < axis.size(); ++i)
+                    for (size_t k = 0; k < i; ++k)
+                        if (axis[i] == axis[k])
+                            throw invalid_argument("GridInterpolator axis repeats a node.");
+                shape[a-1] = axis.size();
+                stride[a-1] = total;
+                total *= axis.size();
+            }
+            if (values.size() != total)
+                throw invalid_argument("GridInterpolator requires one value for every grid node.");
+
+            // Transform the values along each axis in turn, from node values to monomial coefficients.
+            coeff.assign(values.begin(), values.end());
+            vector<range_t> fiber;
+            for (size_t a = 0; a < dims; ++a)
+            {
+                const size_t m = shape[a];
+                const size_t s = stride[a];
+                const vector<domain_t> basis = Internal::lagrangeBasis(nodes[a]);
+                fiber.resize(m);
+                for (size_t outer = 0; outer < total; outer += m*s)
+                {
+                    for (size_t inner = 0; inner < s; ++inner)
+                    {
+                        range_t* c = coeff.data() + outer + inner;
+                        for (size_t j = 0; j < m; ++j)
+                            fiber[j] = c[j*s];
+                        for (size_t p = 0; p < m; ++p)
+                        {
+                            range_t sum{0};
+                            for (size_t j = 0; j < m; ++j)
+                                sum += basis[j*m + p] * fiber[j];
+                            c[p*s] = sum;
+                        }
+                    }
+                }
+            }
+        }
+
+        /// @brief Returns the node coordinates along one axis.
+        const std::vector<domain_t>& axis(std::size_t index) const
+        {
+            return nodes.at(index);
+        }
+
+        /// @brief Returns the tensor of monomial coefficients, in row-major order by increasing power along each axis.
+        const std::vector<range_t, AlignedAllocator<range_t>>& coefficients() const
+        {
+            return coeff;
+        }
+
+        /// @brief Evaluates the interpolating function at a point.
+        /// @param x The coordinates of the point.
+        /// @return The interpolated value.
+        range_t operator() (const point_t& x) const
+        {
+            return evaluateAxis(0, coeff.data(), x);
+        }
+
+        /// @brief Evaluates the interpolating function at a point given as separate coordinates.
+        /// @param coords Exactly `dims` coordinates.
+        /// @return The interpolated value.
+        template<typename... coord_t>
+        range_t operator() (coord_t... coords) const
+        {
+            static_assert(sizeof...(coords) == dims, "GridInterpolator requires one coordinate per dimension.");
+            return evaluateAxis(0, coeff.data(), point_t{static_cast<domain_t>(coords)...});
+        }
+
+        /// @brief Evaluates the interpolating function at an array of points.
+        /// @param x An array of `count` points.
+        /// @param y An array of `count` elements that receives the interpolated values.
+        /// @param count The number of points to evaluate.
+        void evaluate(const point_t* x, range_t* y, std::size_t count) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = evaluateAxis(0, coeff.data(), x[i]);
+        }
+    };
+
+
+    /// @brief Derives a polynomial that matches given values and derivatives at a collection of points.
+    /// @remarks
+    /// Each point supplies `y = f(x)` and optionally `f'(x)`, `f''(x)`, and so on.
+    /// The result is the lowest-degree polynomial that satisfies every condition:
+    /// its degree is one less than the total number of values supplied.
+    /// Known derivatives give the same accuracy as `Interpolator` with far fewer points.
+    /// The polynomial is found by confluent divided differences, in O(n^2) operations
+    /// for n conditions, and then converted from Newton form to ordinary coefficients.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the dependent variable `y` and its derivatives.
+    template<typename domain_t, typename range_t>
+    class HermiteInterpolator
+    {
+    private:
+        struct node_t
+        {
+            domain_t x;
+            std::vector<range_t> values;    // f(x), f'(x), f''(x), ...
+        };
+
+        std::vector<node_t> nodes;
+
+    public:
+        /// @brief Empties the collection of points inside this interpolator.
+        void clear()
+        {
+            nodes.clear();
+        }
+
+        /// @brief Returns the number of points inserted.
+        std::size_t size() const
+        {
+            return nodes.size();
+        }
+
+        /// @brief Returns the total number of values and derivatives supplied, which is one more than the degree of the result.
+        std::size_t conditionCount() const
+        {
+            std::size_t count = 0;
+            for (const node_t& node : nodes)
+                count += node.values.size();
+            return count;
+        }
+
+        /// @brief Inserts a point with its value and any number of derivatives.
+        /// @remarks
+        /// As with `Interpolator::insert`, an `x` value that was already inserted
+        /// is ignored and the call returns `false`.
+        /// Throws `std::invalid_argument` if `values` is empty.
+        /// @param x The value of the independent variable.
+        /// @param values The values `f(x)`, `f'(x)`, `f''(x)`, ... in increasing order of derivative.
+        /// @return If successful, `true`; otherwise `false`.
+        bool insert(domain_t x, const std::vector<range_t>& values)
+        {
+            if (values.empty())
+                throw std::invalid_argument("HermiteInterpolator requires at least a value for each point.");
+            for (const node_t& node : nodes)
+                if (node.x == x)
+                    return false;
+            nodes.push_back(node_t{x, values});
+            return true;
+        }
+
+        /// @brief Inserts a point with its value and any number of derivatives.
+        /// @param x The value of the independent variable.
+        /// @param y The value `f(x)`.
+        /// @param derivatives The values `f'(x)`, `f''(x)`, ... in increasing order of derivative.
+        /// @return If successful, `true`; if `x` was already inserted, `false`.
+        template<typename... deriv_t>
+        bool insert(domain_t x, range_t y, deriv_t... derivatives)
+        {
+            return insert(x, std::vector<range_t>{y, static_cast<range_t>(derivatives)...});
+        }
+
+        /// @brief Calculates the polynomial that matches every supplied value and derivative.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            using namespace std;
+
+            // List each x once for each condition at that point.
+            vector<domain_t> z;
+            vector<size_t> owner;
+            for (size_t j = 0; j < nodes.size(); ++j)
+            {
+                for (size_t k = 0; k < nodes[j].values.size(); ++k)
+                {
+                    z.push_back(nodes[j].x);
+                    owner.push_back(j);
+                }
+            }
+
+            const size_t n = z.size();
+            if (n == 0)
+                return Polynomial<domain_t, range_t>{};
+
+            // Divided differences, one column at a time, in place.
+            // Where all the x values of a difference coincide, it is the derivative divided by a factorial.
+            vector<range_t> diff(n);
+            for (size_t i = 0; i < n; ++i)
+                diff[i] = nodes[owner[i]].values[0];
+            domain_t factorial = 1;
+            for (size_t level = 1; level < n; ++level)
+            {
+                factorial *= static_cast<domain_t>(level);
+                for (size_t i = n-1; i >= level; --i)
+                {
+                    if (owner[i] == owner[i-level])
+                        diff[i] = nodes[owner[i]].values[level] / factorial;
+                    else
+                        diff[i] = (diff[i] - diff[i-1]) / (z[i] - z[i-level]);
+                }
+            }
+
+            // Convert the Newton form a0 + a1*(x-z0) + a2*(x-z0)*(x-z1) + ... to powers of x.
+            vector<range_t> coeffs(n, range_t{0});
+            coeffs[0] = diff[n-1];
+            for (size_t k = n-1, degree = 0; k > 0; --k, ++degree)
+            {
+                const domain_t root = z[k-1];
+                for (size_t m = degree+1; m > 0; --m)
+                    coeffs[m] = coeffs[m-1] - root*coeffs[m];
+                coeffs[0] = diff[k-1] - root*coeffs[0];
+            }
+            return Polynomial<domain_t, range_t>{coeffs};
+        }
+    };
+
+
+    /// @brief Interpolates points with a Floater-Hormann barycentric rational function.
+    /// @remarks
+    /// Polynomial interpolation through many points oscillates wildly and is
+    /// sensitive to rounding. The Floater-Hormann rational interpolant instead blends
+    /// local polynomials of a small degree `d` through each run of `d+1` neighboring points.
+    /// It has no poles on the real line, passes through every point, reproduces
+    /// polynomials of degree up to `d` exactly, and stays well behaved for tens of
+    /// thousands of points in any spacing.
+    /// Points are kept sorted by x. Inserting a point recomputes only the weights of its
+    /// `d` neighbors on each side, at O(d^2) operations each, although shifting the sorted
+    /// arrays to make room still moves O(n) elements. Building the weights for `n` points
+    /// at once costs O(n*d^2), and evaluation costs O(n) with no memory allocation.
+    /// @tparam domain_t A real floating point type for the independent variable `x`.
+    /// @tparam range_t The numeric type of the dependent variable `y`.
+    template<typename domain_t, typename range_t>
+    class RationalInterpolator
+    {
+    private:
+        static_assert(std::is_floating_point<domain_t>::value, "RationalInterpolator requires a real floating point domain.");
+
+        std::size_t blend;
+        std::vector<domain_t> xs;           // sorted
+        std::vector<range_t> ys;
+        std::vector<domain_t> weights;      // magnitudes; the sign of weight k is (-1)^k
+
+        static void rejectNaN(domain_t x)
+        {
+            // NaN compares false with everything, which would break the sorted order.
+            if (std::isnan(x))
+                throw std::invalid_argument("RationalInterpolator x value must not be NaN.");
+        }
+
+        void updateWeight(std::size_t k)
+        {
+            // Sum the reciprocal products of distances from x_k to the other points
+            // of every run of d+1 consecutive points that includes x_k.
+            const std::size_t n = xs.size();
+            const std::size_t d = std::min(blend, n-1);
+            const std::size_t first = (k >= d) ? (k - d) : 0;
+            const std::size_t last = std::min(k, n-1-d);
+            domain_t sum = 0;
+            for (std::size_t i = first; i <= last; ++i)
+            {
+                domain_t product = 1;
+                for (std::size_t j = i; j <= i+d; ++j)
+                    if (j != k)
+                        product *= std::abs(xs[k] - xs[j]);
+                sum += 1 / product;
+            }
+            weights[k] = sum;
+        }
+
+        void updateAllWeights()
+        {
+            weights.resize(xs.size());
+            for (std::size_t k = 0; k < xs.size(); ++k)
+                updateWeight(k);
+        }
+
+    public:
+        /// @brief Creates an empty interpolator with a given blending degree.
+        /// @param blendingDegree
+        /// The degree `d` of the local polynomials that are blended together.
+        /// Larger values converge faster for smooth data; 3 to 8 is typical.
+        explicit RationalInterpolator(std::size_t blendingDegree = 3)
+            : blend(blendingDegree)
+            {}
+
+        /// @brief Returns the degree of the local polynomials that are blended together.
+        std::size_t blendingDegree() const
+        {
+            return blend;
+        }
+
+        /// @brief Empties the collection of points inside this interpolator.
+        void clear()
+        {
+            xs.clear();
+            ys.clear();
+            weights.clear();
+        }
+
+        /// @brief Returns the number of points inserted.
+        std::size_t size() const
+        {
+            return xs.size();
+        }
+
+        /// @brief Inserts another point `(x, y)` to this interpolator.
+        /// @remarks
+        /// As with `Interpolator::insert`, an `x` value that was already inserted
+        /// is ignored and the call returns `false`.
+        /// Throws `std::invalid_argument` if `x` is NaN.
+        /// @param x The value of the independent variable `x` for this point.
+        /// @param y The value of the dependent variable `y` for this point.
+        /// @return If successful, `true`; otherwise `false`.
+        bool insert(domain_t x, range_t y)
+        {
+            using namespace std;
+            rejectNaN(x);
+            const auto position = lower_bound(xs.begin(), xs.end(), x);
+            if (position != xs.end() && *position == x)
+                return false;
+
+            const size_t p = static_cast<size_t>(position - xs.begin());
+            xs.insert(position, x);
+            ys.insert(ys.begin() + p, y);
+            weights.insert(weights.begin() + p, domain_t{0});
+
+            const size_t n = xs.size();
+            if (n-1 <= blend)
+            {
+                // The effective blending degree min(d, n-1) changed, so every weight changes.
+                updateAllWeights();
+            }
+            else
+            {
+                const size_t first = (p >= blend) ? (p - blend) : 0;
+                const size_t last = min(n-1, p + blend);
+                for (size_t k = first; k <= last; ++k)
+                    updateWeight(k);
+            }
+            return true;
+        }
+
+        /// @brief Inserts an array of points `(x[i], y[i])` to this interpolator.
+        /// @remarks
+        /// Has the same effect as inserting each point in turn, but sorts them
+        /// together and calculates every weight once, in O(n*d^2) operations.
+        /// Throws `std::invalid_argument` if any `x` is NaN, before inserting anything.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` values of the dependent variable.
+        /// @param count The number of points in the arrays.
+        /// @return The number of points that were inserted.
+        std::size_t insert(const domain_t* x, const range_t* y, std::size_t count)
+        {
+            using namespace std;
+            for (size_t i = 0; i < count; ++i)
+                rejectNaN(x[i]);
+            vector<size_t> order(count);
+            for (size_t i = 0; i < count; ++i)
+                order[i] = i;
+            stable_sort(order.begin(), order.end(), [x](size_t a, size_t b) { return x[a] < x[b]; });
+
+            vector<domain_t> mergedX;
+            vector<range_t> mergedY;
+            mergedX.reserve(xs.size() + count);
+            mergedY.reserve(ys.size() + count);
+            size_t i = 0;
+            size_t accepted = 0;
+            for (size_t k = 0; k < count; ++k)
+            {
+                const domain_t value = x[order[k]];
+                while (i < xs.size() && xs[i] < value)
+                {
+                    mergedX.push_back(xs[i]);
+                    mergedY.push_back(ys[i]);
+                    ++i;
+                }
+                if ((i < xs.size() && xs[i] == value) || (!mergedX.empty() && mergedX.back() == value))
+                    continue;
+                mergedX.push_back(value);
+                mergedY.push_back(y[order[k]]);
+                ++accepted;
+            }
+            mergedX.insert(mergedX.end(), xs.begin() + i, xs.end());
+            mergedY.insert(mergedY.end(), ys.begin() + i, ys.end());
+
+            xs.swap(mergedX);
+            ys.swap(mergedY);
+            updateAllWeights();
+            return accepted;
+        }
+
+        /// @brief Evaluates the rational interpolant at a given value of x.
+        /// @param x The value of the independent variable.
+        /// @return The interpolated value, or exactly `y` for an inserted point `(x, y)`.
+        range_t operator() (domain_t x) const
+        {
+            using namespace std;
+            const size_t n = xs.size();
+            if (n == 0)
+                return range_t{0};
+
+            const auto position = lower_bound(xs.begin(), xs.end(), x);
+            if (position != xs.end() && *position == x)
+                return ys[static_cast<size_t>(position - xs.begin())];
+
+            // The weights alternate in sign, which is applied here by index,
+            // so that inserting a point never has to touch the weights after it.
+            range_t numer{0};
+            domain_t denom = 0;
+            domain_t sign = 1;
+            for (size_t k = 0; k < n; ++k)
+            {
+                const domain_t t = sign * weights[k] / (x - xs[k]);
+                numer += t * ys[k];
+                denom += t;
+                sign = -sign;
+            }
+            return numer / denom;
+        }
+
+        /// @brief Evaluates the rational interpolant for an array of x values.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the interpolated values.
+        /// @param count The number of values to evaluate.
+        void evaluate(const domain_t* x, range_t* y, std::size_t count) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = (*this)(x[i]);
+        }
+    };
+
+
+    /// @brief Fits a polynomial of a chosen degree to any number of points by least squares.
+    /// @remarks
+    /// Points are added one at a time and not stored: the fitter keeps only a small
+    /// triangular factor whose size depends on the degree, so millions of samples
+    /// can be fitted in constant memory.
+    /// Each point becomes a row of Chebyshev polynomial values over the interval `[lower, upper]`,
+    /// which is folded into the QR factorization of all rows so far by Givens rotations.
+    /// This avoids the loss of accuracy of solving the normal equations.
+    /// Fitters for separate parts of the data, for example on separate threads,
+    /// can be combined with #merge.
+    /// Points outside the interval are allowed, but the fit is best conditioned inside it.
+    /// @tparam domain_t A real floating point type for the independent variable `x`.
+    /// @tparam range_t A real floating point type for the dependent variable `y`.
+    template<typename domain_t, typename range_t>
+    class LeastSquaresFitter
+    {
+    private:
+        static_assert(std::is_floating_point<domain_t>::value && std::is_floating_point<range_t>::value, "LeastSquaresFitter requires real floating point types.");
+
+        std::size_t columns;
+        domain_t lower;
+        domain_t upper;
+        domain_t center;
+        domain_t inverseHalfWidth;
+        std::vector<range_t> R;         // columns-by-columns upper triangular factor, row by row
+        std::vector<range_t> rhs;       // Q^T y
+        range_t residualSquares = 0;
+        std::size_t samples = 0;
+        std::vector<range_t> scratch;   // the row being added
+
+        void rotateIn(range_t* row, range_t value)
+        {
+            // Apply Givens rotations that zero each element of the row against the diagonal of R.
+            using namespace std;
+            for (size_t k = 0; k < columns; ++k)
+            {
+                if (row[k] == 0)
+                    continue;
+                range_t* rk = R.data() + k*columns;
+                const range_t radius = hypot(rk[k], row[k]);
+                const range_t c = rk[k] / radius;
+                const range_t s = row[k] / radius;
+                rk[k] = radius;
+                for (size_t j = k+1; j < columns; ++j)
+                {
+                    const range_t a = rk[j];
+                    rk[j] = c*a + s*row[j];
+                    row[j] = c*row[j] - s*a;
+                }
+                const range_t b = rhs[k];
+                rhs[k] = c*b + s*value;
+                value = c*value - s*b;
+            }
+            residualSquares += value*value;
+        }
+
+    public:
+        /// @brief Creates a fitter for a polynomial of a given degree.
+        /// @remarks Throws `std::invalid_argument` unless `a < b`.
+        /// @param degree The degree of the fitted polynomial.
+        /// @param a The lower end of the interval where the points are expected.
+        /// @param b The upper end of the interval where the points are expected.
+        LeastSquaresFitter(std::size_t degree, domain_t a = -1, domain_t b = +1)
+            : columns(degree + 1)
+            , lower(a)
+            , upper(b)
+            , center((a + b) / 2)
+            , inverseHalfWidth(2 / (b - a))
+            , R(columns*columns, range_t{0})
+            , rhs(columns, range_t{0})
+            , scratch(columns)
+        {
+            if (!(a < b))
+                throw std::invalid_argument("LeastSquaresFitter interval must have lower < upper.");
+        }
+
+        /// @brief Returns the degree of the fitted polynomial.
+        std::size_t degree() const
+        {
+            return columns - 1;
+        }
+
+        /// @brief Returns the number of points added, including points added to merged fitters.
+        std::size_t count() const
+        {
+            return samples;
+        }
+
+        /// @brief Adds a point to the fit.
+        /// @remarks Throws `std::invalid_argument` if `weight` is negative or NaN.
+        /// @param x The value of the independent variable.
+        /// @param y The value of the dependent variable.
+        /// @param weight A nonnegative weight for the point's squared error.
+        void add(domain_t x, range_t y, range_t weight = 1)
+        {
+            if (!(weight >= 0))
+                throw std::invalid_argument("LeastSquaresFitter weight must be nonnegative.");
+            const range_t scale = std::sqrt(weight);
+            const range_t u = static_cast<range_t>((x - center) * inverseHalfWidth);
+            range_t* r = scratch.data();
+            range_t t0 = 1;
+            range_t t1 = u;
+            for (std::size_t k = 0; k < columns; ++k)
+            {
+                r[k] = scale * t0;
+                const range_t t2 = 2*u*t1 - t0;
+                t0 = t1;
+                t1 = t2;
+            }
+            rotateIn(r, scale * y);
+            ++samples;
+        }
+
+        /// @brief Adds an array of points to the fit.
+        /// @param x An array of `n` values of the independent variable.
+        /// @param y An array of `n` values of the dependent variable.
+        /// @param n The number of points.
+        void add(const domain_t* x, const range_t* y, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                add(x[i], y[i]);
+        }
+
+        /// @brief Adds an array of weighted points to the fit.
+        /// @remarks
+        /// Throws `std::invalid_argument` if any weight is negative or NaN,
+        /// in which case none of the points are added.
+        /// @param x An array of `n` values of the independent variable.
+        /// @param y An array of `n` values of the dependent variable.
+        /// @param weights An array of `n` nonnegative weights for the points' squared errors.
+        /// @param n The number of points.
+        void add(const domain_t* x, const range_t* y, const range_t* weights, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                if (!(weights[i] >= 0))
+                    throw std::invalid_argument("LeastSquaresFitter weight must be nonnegative.");
+            for (std::size_t i = 0; i < n; ++i)
+                add(x[i], y[i], weights[i]);
+        }
+
+        /// @brief Combines the points of another fitter into this one.
+        /// @remarks
+        /// The result is the same, up to rounding, as if every point added to `other`
+        /// had been added to this fitter.
+        /// Throws `std::invalid_argument` if the fitters have different degrees or intervals.
+        /// @param other A fitter with the same degree and interval.
+        void merge(const LeastSquaresFitter& other)
+        {
+            if (other.columns != columns || other.lower != lower || other.upper != upper)
+                throw std::invalid_argument("LeastSquaresFitter can only merge fitters with the same degree and interval.");
+            std::vector<range_t> row(columns);
+            for (std::size_t k = 0; k < columns; ++k)
+            {
+                std::copy_n(other.R.begin() + k*columns, columns, row.begin());
+                rotateIn(row.data(), other.rhs[k]);
+            }
+            residualSquares += other.residualSquares;
+            samples += other.samples;
+        }
+
+        /// @brief Returns the square root of the sum of the weighted squared errors of the fit.
+        range_t residual() const
+        {
+            return std::sqrt(residualSquares);
+        }
+
+        /// @brief Calculates the least-squares fit as a Chebyshev series over the fitter's interval.
+        /// @remarks
+        /// Throws `std::range_error` if the points do not determine a unique polynomial,
+        /// for example when there are fewer distinct x values than `degree()+1`.
+        ChebyshevSeries<range_t, range_t> chebyshevSeries() const
+        {
+            using namespace std;
+            range_t largest = 0;
+            for (size_t k = 0; k < columns; ++k)
+                largest = max(largest, abs(R[k*columns + k]));
+
+            vector<range_t> c(columns);
+            for (size_t k = columns; k > 0; --k)
+            {
+                const size_t i = k - 1;
+                const range_t diagonal = R[i*columns + i];
+                if (!(abs(diagonal) > largest * numeric_limits<range_t>::epsilon() * static_cast<range_t>(columns)))
+                    throw range_error("LeastSquaresFitter does not have enough distinct points for the requested degree.");
+                range_t sum = rhs[i];
+                for (size_t j = i+1; j < columns; ++j)
+                    sum -= R[i*columns + j] * c[j];
+                c[i] = sum / diagonal;
+            }
+            return ChebyshevSeries<range_t, range_t>{c, static_cast<range_t>(lower), static_cast<range_t>(upper)};
+        }
+
+        /// @brief Calculates the least-squares fit as a polynomial.
+        /// @remarks
+        /// Throws `std::range_error` if the points do not determine a unique polynomial.
+        Polynomial<domain_t, range_t> polynomial() const
+        {
+            return Polynomial<domain_t, range_t>{chebyshevSeries().toPolynomial().coefficients()};
+        }
+    };
+
+
+    /// @brief Selects how complex products are calculated.
+    enum class ComplexMultiply
+    {
+        Strict,     ///< Uses `std::complex` multiplication, with its special handling of infinite and NaN values.
+        Fast,       ///< Uses the plain formula `(a+bi)(c+di) = (ac-bd) + (ad+bc)i`, like compiling with fast math.
+    };
+
+
+    /// @brief A complex-valued polynomial whose coefficients are stored as separate real and imaginary arrays.
+    /// @remarks
+    /// Evaluates the same function as `Polynomial<real_t, std::complex<real_t>>`, but
+    /// the split layout lets the batch functions work on plain real arrays, which the
+    /// compiler can vectorize with fused multiply-adds.
+    /// At real x, no complex multiplication is needed at all.
+    /// At complex x, products follow the `ComplexMultiply` mode: `Strict` gives the same
+    /// results as `std::complex`, and `Fast` skips its checks for infinite and NaN values.
+    /// @tparam real_t A real floating point type for the parts of the coefficients.
+    template<typename real_t>
+    class SplitComplexPolynomial
+    {
+    public:
+        /// @brief The complex type of the polynomial's values.
+        using complex_t = std::complex<real_t>;
+
+    private:
+        using array_t = std::vector<real_t, AlignedAllocator<real_t>>;
+        static constexpr std::size_t evaluateBlockSize = 256;
+
+        array_t re;
+        array_t im;
+
+        template<typename coeff_t>
+        void assign(const std::vector<coeff_t>& coefficients)
+        {
+            const std::size_t n = coefficients.size();
+            re.resize(n);
+            im.resize(n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const complex_t c{coefficients[k]};
+                re[k] = c.real();
+                im[k] = c.imag();
+            }
+        }
+
+    public:
+        /// @brief Creates a polynomial from complex coefficients.
+        /// @param coefficients The coefficients in increasing order of power of `x`.
+        explicit SplitComplexPolynomial(const std::vector<complex_t>& coefficients = {})
+        {
+            assign(coefficients);
+        }
+
+        /// @brief Creates a split copy of a complex-valued polynomial of a real variable.
+        explicit SplitComplexPolynomial(const Polynomial<real_t, complex_t>& poly)
+        {
+            assign(poly.coefficients());
+        }
+
+        /// @brief Creates a split copy of a complex-valued polynomial of a complex variable.
+        explicit SplitComplexPolynomial(const Polynomial<complex_t, complex_t>& poly)
+        {
+            assign(poly.coefficients());
+        }
+
+        /// @brief Returns the number of coefficients.
+        std::size_t size() const
+        {
+            return re.size();
+        }
+
+        /// @brief Returns the real parts of the coefficients, in increasing order of power of `x`.
+        const array_t& realParts() const
+        {
+            return re;
+        }
+
+        /// @brief Returns the imaginary parts of the coefficients, in increasing order of power of `x`.
+        const array_t& imaginaryParts() const
+        {
+            return im;
+        }
+
+        /// @brief Copies the coefficients back into a `Polynomial`.
+        Polynomial<real_t, complex_t> toPolynomial() const
+        {
+            std::vector<complex_t> c(re.size());
+            for (std::size_t k = 0; k < c.size(); ++k)
+                c[k] = complex_t{re[k], im[k]};
+            return Polynomial<real_t, complex_t>{c};
+        }
+
+        /// @brief Evaluates the polynomial at a real value of x.
+        complex_t operator() (real_t x) const
+        {
+            std::size_t k = re.size();
+            if (k == 0)
+                return complex_t{0};
+            --k;
+            real_t yr = re[k];
+            real_t yi = im[k];
+            while (k > 0)
+            {
+                --k;
+                yr = x*yr + re[k];
+                yi = x*yi + im[k];
+            }
+            return complex_t{yr, yi};
+        }
+
+        /// @brief Evaluates the polynomial at a complex value of x.
+        /// @param z The value of the independent variable.
+        /// @param mode How to calculate complex products.
+        complex_t operator() (complex_t z, ComplexMultiply mode = ComplexMultiply::Strict) const
+        {
+            std::size_t k = re.size();
+            if (k == 0)
+                return complex_t{0};
+            --k;
+            if (mode == ComplexMultiply::Strict)
+            {
+                complex_t y{re[k], im[k]};
+                while (k > 0)
+                {
+                    --k;
+                    y = z*y + complex_t{re[k], im[k]};
+                }
+                return y;
+            }
+
+            const real_t zr = z.real();
+            const real_t zi = z.imag();
+            real_t yr = re[k];
+            real_t yi = im[k];
+            while (k > 0)
+            {
+                --k;
+                const real_t tr = zr*yr - zi*yi + re[k];
+                yi = zr*yi + zi*yr + im[k];
+                yr = tr;
+            }
+            return complex_t{yr, yi};
+        }
+
+        /// @brief Evaluates the polynomial for an array of real x values, writing split results.
+        /// @remarks
+        /// Points are processed in cache-sized blocks, and each coefficient is applied
+        /// to a whole block at once in loops the compiler can vectorize.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param yRe An array of `count` elements that receives the real parts of f(x).
+        /// @param yIm An array of `count` elements that receives the imaginary parts of f(x).
+        /// @param count The number of values to evaluate.
+        void evaluate(const real_t* x, real_t* yRe, real_t* yIm, std::size_t count) const
+        {
+            using namespace std;
+            const size_t n = re.size();
+            for (size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const size_t stop = min(count, start + evaluateBlockSize);
+                const real_t topRe = (n > 0) ? re[n-1] : real_t{0};
+                const real_t topIm = (n > 0) ? im[n-1] : real_t{0};
+                for (size_t i = start; i < stop; ++i)
+                {
+                    yRe[i] = topRe;
+                    yIm[i] = topIm;
+                }
+                for (size_t k = n; k > 1; --k)
+                {
+                    const real_t cr = re[k-2];
+                    const real_t ci = im[k-2];
+                    for (size_t i = start; i < stop; ++i)
+                    {
+                        yRe[i] = x[i]*yRe[i] + cr;
+                        yIm[i] = x[i]*yIm[i] + ci;
+                    }
+                }
+            }
+        }
+
+        /// @brief Evaluates the polynomial for an array of complex x values given as split arrays.
+        /// @remarks
+        /// With `ComplexMultiply::Fast`, the points are processed in blocks of plain real
+        /// arithmetic that the compiler can vectorize. With `ComplexMultiply::Strict`,
+        /// each point is evaluated with `std::complex` arithmetic.
+        /// @param zRe An array of `count` real parts of the independent variable.
+        /// @param zIm An array of `count` imaginary parts of the independent variable.
+        /// @param yRe An array of `count` elements that receives the real parts of f(z).
+        /// @param yIm An array of `count` elements that receives the imaginary parts of f(z).
+        /// @param count The number of values to evaluate.
+        /// @param mode How to calculate complex products.
+        void evaluate(
+            const real_t* zRe,
+            const real_t* zIm,
+            real_t* yRe,
+            real_t* yIm,
+            std::size_t count,
+            ComplexMultiply mode = ComplexMultiply::Strict) const
+        {
+            using namespace std;
+            if (mode == ComplexMultiply::Strict)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const complex_t y = (*this)(complex_t{zRe[i], zIm[i]}, mode);
+                    yRe[i] = y.real();
+                    yIm[i] = y.imag();
+                }
+                return;
+            }
+
+            const size_t n = re.size();
+            for (size_t start = 0; start < count; start += evaluateBlockSize)
+            {
+                const size_t stop = min(count, start + evaluateBlockSize);
+                const real_t topRe = (n > 0) ? re[n-1] : real_t{0};
+                const real_t topIm = (n > 0) ? im[n-1] : real_t{0};
+                for (size_t i = start; i < stop; ++i)
+                {
+                    yRe[i] = topRe;
+                    yIm[i] = topIm;
+                }
+                for (size_t k = n; k > 1; --k)
+                {
+                    const real_t cr = re[k-2];
+                    const real_t ci = im[k-2];
+                    for (size_t i = start; i < stop; ++i)
+                    {
+                        const real_t tr = zRe[i]*yRe[i] - zIm[i]*yIm[i] + cr;
+                        yIm[i] = zRe[i]*yIm[i] + zIm[i]*yRe[i] + ci;
+                        yRe[i] = tr;
+                    }
+                }
+            }
+        }
+    };
+
+
+    namespace Internal
+    {
+        // Binary format, all fields little-endian:
+        //   0  magic "CKIP"
+        //   4  uint16 version
+        //   6  uint8  kind (1 = polynomial coefficients, 2 = interpolator points)
+        //   7  uint8  domain type tag
+        //   8  uint8  range type tag
+        //   9  7 reserved bytes, zero
+        //  16  uint64 element count (coefficients or points)
+        //  24  uint64 FNV-1a checksum of the payload
+        //  32  payload: coefficients, or (x, y) pairs
+        constexpr std::size_t binaryHeaderSize = 32;
+        constexpr std::uint16_t binaryVersion = 1;
+        constexpr std::uint8_t binaryKindPolynomial = 1;
+        constexpr std::uint8_t binaryKindPoints = 2;
+
+        inline bool hostIsLittleEndian()
+        {
+            const std::uint16_t one = 1;
+            unsigned char first;
+            std::memcpy(&first, &one, 1);
+            return first == 1;
+        }
+
+        template<typename uint_t>
+        void putLittleEndian(unsigned char* bytes, uint_t value)
+        {
+            for (std::size_t i = 0; i < sizeof(uint_t); ++i)
+                bytes[i] = static_cast<unsigned char>(value >> (8*i));
+        }
+
+        template<typename uint_t>
+        uint_t getLittleEndian(const unsigned char* bytes)
+        {
+            uint_t value = 0;
+            for (std::size_t i = 0; i < sizeof(uint_t); ++i)
+                value |= static_cast<uint_t>(bytes[i]) << (8*i);
+            return value;
+        }
+
+        template<typename real_t, typename uint_t, std::uint8_t typeTag>
+        struct BinaryReal
+        {
+            static_assert(std::numeric_limits<real_t>::is_iec559 && sizeof(real_t) == sizeof(uint_t), "Binary format requires IEEE 754 floating point.");
+            static constexpr std::uint8_t tag = typeTag;
+            static constexpr std::size_t size = sizeof(real_t);
+
+            static void put(unsigned char* bytes, real_t value)
+            {
+                uint_t bits;
+                std::memcpy(&bits, &value, size);
+                putLittleEndian(bytes, bits);
+            }
+
+            static real_t get(const unsigned char* bytes)
+            {
+                const uint_t bits = getLittleEndian<uint_t>(bytes);
+                real_t value;
+                std::memcpy(&value, &bits, size);
+                return value;
+            }
+        };
+
+        template<typename real_t, std::uint8_t typeTag>
+        struct BinaryComplex
+        {
+            using part_t = BinaryReal<real_t, typename std::conditional<sizeof(real_t) == 4, std::uint32_t, std::uint64_t>::type, 0>;
+            static constexpr std::uint8_t tag = typeTag;
+            static constexpr std::size_t size = 2 * part_t::size;
+
+            static void put(unsigned char* bytes, const std::complex<real_t>& value)
+            {
+                part_t::put(bytes, value.real());
+                part_t::put(bytes + part_t::size, value.imag());
+            }
+
+            static std::complex<real_t> get(const unsigned char* bytes)
+            {
+                return std::complex<real_t>{part_t::get(bytes), part_t::get(bytes + part_t::size)};
+            }
+        };
+
+        // The binary format supports only these element types, so files are portable between platforms.
+        template<typename value_t> struct BinaryTraits;
+        template<> struct BinaryTraits<float> : BinaryReal<float, std::uint32_t, 1> {};
+        template<> struct BinaryTraits<double> : BinaryReal<double, std::uint64_t, 2> {};
+        template<> struct BinaryTraits<std::complex<float>> : BinaryComplex<float, 3> {};
+        template<> struct BinaryTraits<std::complex<double>> : BinaryComplex<double, 4> {};
+
+        constexpr std::uint64_t fnv1aBasis = 14695981039346656037ull;
+
+        inline std::uint64_t fnv1a(const unsigned char* bytes, std::size_t length, std::uint64_t hash = fnv1aBasis)
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        struct BinaryHeader
+        {
+            std::uint8_t kind;
+            std::uint8_t domainTag;
+            std::uint8_t rangeTag;
+            std::uint64_t count;
+            std::uint64_t checksum;
+        };
+
+        inline void encodeHeader(unsigned char* bytes, const BinaryHeader& header)
+        {
+            std::memset(bytes, 0, binaryHeaderSize);
+            std::memcpy(bytes, "CKIP", 4);
+            putLittleEndian(bytes + 4, binaryVersion);
+            bytes[6] = header.kind;
+            bytes[7] = header.domainTag;
+            bytes[8] = header.rangeTag;
+            putLittleEndian(bytes + 16, header.count);
+            putLittleEndian(bytes + 24, header.checksum);
+        }
+
+        template<typename domain_t, typename range_t>
+        BinaryHeader decodeHeader(const unsigned char* bytes, std::uint8_t kind)
+        {
+            using namespace std;
+            if (memcmp(bytes, "CKIP", 4) != 0)
+                throw runtime_error("Binary data does not start with the expected signature.");
+            if (getLittleEndian<uint16_t>(bytes + 4) != binaryVersion)
+                throw runtime_error("Binary data has an unsupported version.");
+
+            BinaryHeader header;
+            header.kind = bytes[6];
+            header.domainTag = bytes[7];
+            header.rangeTag = bytes[8];
+            header.count = getLittleEndian<uint64_t>(bytes + 16);
+            header.checksum = getLittleEndian<uint64_t>(bytes + 24);
+
+            if (header.kind != kind)
+                throw runtime_error("Binary data holds a different kind of object.");
+            if (header.domainTag != BinaryTraits<domain_t>::tag || header.rangeTag != BinaryTraits<range_t>::tag)
+                throw runtime_error("Binary data holds different numeric types.");
+            return header;
+        }
+
+        inline void writeBinaryRecord(std::ostream& out, BinaryHeader header, const std::vector<unsigned char>& payload)
+        {
+            unsigned char bytes[binaryHeaderSize];
+            header.checksum = fnv1a(payload.data(), payload.size());
+            encodeHeader(bytes, header);
+            out.write(reinterpret_cast<const char*>(bytes), binaryHeaderSize);
+            out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+            if (!out)
+                throw std::runtime_error("Failure writing binary data.");
+        }
+
+        template<typename domain_t, typename range_t>
+        std::vector<unsigned char> readBinaryRecord(std::istream& in, std::uint8_t kind, std::size_t elementSize, BinaryHeader& header)
+        {
+            using namespace std;
+            unsigned char bytes[binaryHeaderSize];
+            if (!in.read(reinterpret_cast<char*>(bytes), binaryHeaderSize))
+                throw runtime_error("Binary data is truncated.");
+            header = decodeHeader<domain_t, range_t>(bytes, kind);
+
+            if (header.count > numeric_limits<size_t>::max() / elementSize)
+                throw runtime_error("Binary data has an invalid element count.");
+            const size_t total = static_cast<size_t>(header.count) * elementSize;
+
+            // The count comes from the data itself, so do not trust it for an allocation.
+            // When the stream can seek, compare it with the number of bytes remaining.
+            const streampos here = in.tellg();
+            if (here != streampos(-1))
+            {
+                in.seekg(0, ios::end);
+                const streampos end = in.tellg();
+                in.clear();
+                in.seekg(here);
+                if (end != streampos(-1) && static_cast<uint64_t>(end - here) < total)
+                    throw runtime_error("Binary data is truncated.");
+            }
+
+            // Otherwise read in bounded chunks, so the buffer grows only as data actually arrives.
+            const size_t chunkSize = 1 << 16;
+            vector<unsigned char> payload;
+            while (payload.size() < total)
+            {
+                const size_t offset = payload.size();
+                const size_t n = min(chunkSize, total - offset);
+                payload.resize(offset + n);
+                if (!in.read(reinterpret_cast<char*>(payload.data() + offset), static_cast<streamsize>(n)))
+                    throw runtime_error("Binary data is truncated.");
+            }
+            if (fnv1a(payload.data(), payload.size()) != header.checksum)
+                throw runtime_error("Binary data checksum does not match.");
+            return payload;
+        }
+    }
+
+
+    /// @brief A read-only view of polynomial coefficients stored somewhere else, such as a loaded file.
+    /// @remarks
+    /// Evaluates the polynomial directly from the referenced memory without copying it.
+    /// The memory must remain valid, and unchanged, for as long as the view is used.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the polynomial `y = f(x)`.
+    template<typename domain_t, typename range_t>
+    class PolynomialView
+    {
+    private:
+        const range_t* coeff;
+        std::size_t count;
+
+    public:
+        /// @brief Creates a view of an array of coefficients.
+        /// @param coefficients The coefficients in increasing order of power of `x`.
+        /// @param coefficientCount The number of coefficients, or zero for the zero polynomial.
+        PolynomialView(const range_t* coefficients = nullptr, std::size_t coefficientCount = 0)
+            : coeff(coefficients)
+            , count(coefficientCount)
+            {}
+
+        /// @brief Returns a pointer to the coefficients, in increasing order of power of `x`.
+        const range_t* data() const
+        {
+            return coeff;
+        }
+
+        /// @brief Returns the number of coefficients.
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /// @brief Evaluates the polynomial for a given value of x.
+        range_t operator() (domain_t x) const
+        {
+            if (count == 0)
+                return range_t{0};
+            std::size_t k = count;
+            range_t sum = coeff[--k];
+            while (k > 0)
+                sum = x*sum + coeff[--k];
+            return sum;
+        }
+
+        /// @brief Evaluates the polynomial for an array of x values.
+        /// @param x An array of `count` values of the independent variable.
+        /// @param y An array of `count` elements that receives the function values.
+        /// @param n The number of values to evaluate.
+        void evaluate(const domain_t* x, range_t* y, std::size_t n) const
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                y[i] = (*this)(x[i]);
+        }
+
+        /// @brief Copies the coefficients into a new `Polynomial`.
+        Polynomial<domain_t, range_t> toPolynomial() const
+        {
+            return Polynomial<domain_t, range_t>{std::vector<range_t>(coeff, coeff + count)};
+        }
+    };
+
+
+    /// @brief Writes the coefficients of a polynomial in a compact, portable binary format.
+    /// @remarks
+    /// The data starts with a 32-byte header that holds a signature, a version number,
+    /// tags for the numeric types, the number of coefficients, and a checksum.
+    /// The coefficients follow as little-endian IEEE 754 values, regardless of the host byte order.
+    /// Supported numeric types are `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+    /// Throws `std::runtime_error` if the stream fails.
+    /// @param out The stream that receives the binary data. It should be opened in binary mode.
+    /// @param poly The polynomial to write.
+    template<typename domain_t, typename range_t>
+    void writeBinary(std::ostream& out, const Polynomial<domain_t, range_t>& poly)
+    {
+        using traits = Internal::BinaryTraits<range_t>;
+        const std::vector<range_t>& coeffs = poly.coefficients();
+        std::vector<unsigned char> payload(coeffs.size() * traits::size);
+        for (std::size_t i = 0; i < coeffs.size(); ++i)
+            traits::put(payload.data() + i*traits::size, coeffs[i]);
+
+        Internal::BinaryHeader header{Internal::binaryKindPolynomial, Internal::BinaryTraits<domain_t>::tag, traits::tag, coeffs.size(), 0};
+        Internal::writeBinaryRecord(out, header, payload);
+    }
+
+
+    /// @brief Writes the points inserted into an interpolator in a compact, portable binary format.
+    /// @remarks
+    /// Uses the same header as the polynomial format, followed by the `(x, y)` pairs in insertion order.
+    /// Throws `std::runtime_error` if the stream fails.
+    /// @param out The stream that receives the binary data. It should be opened in binary mode.
+    /// @param interp The interpolator whose points are written.
+    template<typename domain_t, typename range_t>
+    void writeBinary(std::ostream& out, const Interpolator<domain_t, range_t>& interp)
+    {
+        using xtraits = Internal::BinaryTraits<domain_t>;
+        using ytraits = Internal::BinaryTraits<range_t>;
+        const std::size_t pointSize = xtraits::size + ytraits::size;
+        const std::size_t n = interp.size();
+        std::vector<unsigned char> payload(n * pointSize);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::pair<domain_t, range_t> p = interp.point(i);
+            xtraits::put(payload.data() + i*pointSize, p.first);
+            ytraits::put(payload.data() + i*pointSize + xtraits::size, p.second);
+        }
+
+        Internal::BinaryHeader header{Internal::binaryKindPoints, xtraits::tag, ytraits::tag, n, 0};
+        Internal::writeBinaryRecord(out, header, payload);
+    }
+
+
+    /// @brief Reads a polynomial written by #writeBinary.
+    /// @remarks
+    /// Throws `std::runtime_error` if the data is truncated, fails its checksum,
+    /// or was written for a different object or numeric types.
+    /// @param in The stream that supplies the binary data. It should be opened in binary mode.
+    /// @return The polynomial that was written.
+    template<typename domain_t, typename range_t>
+    Polynomial<domain_t, range_t> readPolynomial(std::istream& in)
+    {
+        using traits = Internal::BinaryTraits<range_t>;
+        Internal::BinaryHeader header;
+        const std::vector<unsigned char> payload = Internal::readBinaryRecord<domain_t, range_t>(in, Internal::binaryKindPolynomial, traits::size, header);
+        std::vector<range_t> coeffs(static_cast<std::size_t>(header.count));
+        for (std::size_t i = 0; i < coeffs.size(); ++i)
+            coeffs[i] = traits::get(payload.data() + i*traits::size);
+        return Polynomial<domain_t, range_t>{coeffs};
+    }
+
+
+    /// @brief Reads interpolator points written by #writeBinary.
+    /// @remarks
+    /// Throws `std::runtime_error` if the data is truncated, fails its checksum,
+    /// or was written for a different object or numeric types.
+    /// @param in The stream that supplies the binary data. It should be opened in binary mode.
+    /// @return An interpolator holding the points that were written.
+    template<typename domain_t, typename range_t>
+    Interpolator<domain_t, range_t> readInterpolator(std::istream& in)
+    {
+        using xtraits = Internal::BinaryTraits<domain_t>;
+        using ytraits = Internal::BinaryTraits<range_t>;
+        const std::size_t pointSize = xtraits::size + ytraits::size;
+        Internal::BinaryHeader header;
+        const std::vector<unsigned char> payload = Internal::readBinaryRecord<domain_t, range_t>(in, Internal::binaryKindPoints, pointSize, header);
+        const std::size_t n = static_cast<std::size_t>(header.count);
+        std::vector<domain_t> xs(n);
+        std::vector<range_t> ys(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const unsigned char* p = payload.data() + i*pointSize;
+            xs[i] = xtraits::get(p);
+            ys[i] = ytraits::get(p + xtraits::size);
+        }
+        Interpolator<domain_t, range_t> interp;
+        if (interp.insert(xs.data(), ys.data(), n) != n)
+            throw std::runtime_error("Binary data contains duplicate x values.");
+        return interp;
+    }
+
+
+    /// @brief Returns a view of a binary polynomial already in memory, without copying the coefficients.
+    /// @remarks
+    /// The memory must hold data written by #writeBinary, for example a file that has been loaded
+    /// or mapped into memory, and must remain valid while the view is used.
+    /// Zero-copy access requires a little-endian host, and the coefficients must be suitably aligned
+    /// for `range_t`, which holds when `data` itself is aligned to at least 32 bytes.
+    /// Throws `std::runtime_error` if the data is invalid, or cannot be viewed in place on this host.
+    /// @param data The start of the binary data.
+    /// @param size The number of bytes available at `data`.
+    /// @param verifyChecksum Whether to verify the checksum, which requires reading every coefficient once.
+    /// @return A view of the polynomial's coefficients inside `data`.
+    template<typename domain_t, typename range_t>
+    PolynomialView<domain_t, range_t> viewPolynomial(const void* data, std::size_t size, bool verifyChecksum = true)
+    {
+        using namespace std;
+        using traits = Internal::BinaryTraits<range_t>;
+        static_assert(sizeof(range_t) == traits::size, "Zero-copy access requires range_t to match its stored size.");
+
+        if (!Internal::hostIsLittleEndian())
+            throw runtime_error("Zero-copy binary access requires a little-endian host.");
+        if (size < Internal::binaryHeaderSize)
+            throw runtime_error("Binary data is truncated.");
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        const Internal::BinaryHeader header = Internal::decodeHeader<domain_t, range_t>(bytes, Internal::binaryKindPolynomial);
+        if (header.count > (size - Internal::binaryHeaderSize) / traits::size)
+            throw runtime_error("Binary data is truncated.");
+
+        const unsigned char* payload = bytes + Internal::binaryHeaderSize;
+        const size_t count = static_cast<size_t>(header.count);
+        if (reinterpret_cast<uintptr_t>(payload) % alignof(range_t) != 0)
+            throw runtime_error("Binary data is not aligned for zero-copy access.");
+        if (verifyChecksum && Internal::fnv1a(payload, count * traits::size) != header.checksum)
+            throw runtime_error("Binary data checksum does not match.");
+
+        return PolynomialView<domain_t, range_t>{reinterpret_cast<const range_t*>(payload), count};
+    }
+
+
+
+    namespace Internal
+    {
+        // Polynomial bank format, all fields little-endian:
+        //   0  magic "CKPB"
+        //   4  uint16 version
+        //   6  uint8  domain type tag
+        //   7  uint8  range type tag
+        //   8  uint64 number of polynomials
+        //  16  reserved, zero up to byte 64
+        //  64  table of (uint64 byte offset, uint64 coefficient count) for each polynomial
+        // Each polynomial's coefficients start at an offset that is a multiple of 64 bytes.
+        constexpr std::size_t bankHeaderSize = 64;
+        constexpr std::size_t bankEntrySize = 16;
+        constexpr std::size_t bankAlignment = 64;
+        constexpr std::uint16_t bankVersion = 1;
+
+        inline std::size_t bankAlign(std::size_t offset)
+        {
+            return (offset + bankAlignment - 1) / bankAlignment * bankAlignment;
+        }
+    }
+
+
+    /// @brief Writes a collection of polynomials as a file that #PolynomialBank can map into memory.
+    /// @remarks
+    /// The output holds a header, a table with the location and size of each polynomial,
+    /// and then each polynomial's coefficients as little-endian IEEE 754 values starting
+    /// on a 64-byte boundary.
+    /// Supported numeric types are `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+    /// Throws `std::runtime_error` if the stream fails.
+    /// @param out The stream that receives the binary data. It should be opened in binary mode.
+    /// @param polynomials The polynomials to write, in the order they will be indexed.
+    template<typename domain_t, typename range_t>
+    void writePolynomialBank(std::ostream& out, const std::vector<Polynomial<domain_t, range_t>>& polynomials)
+    {
+        using namespace std;
+        using traits = Internal::BinaryTraits<range_t>;
+        const size_t count = polynomials.size();
+
+        vector<unsigned char> head(Internal::bankHeaderSize + count*Internal::bankEntrySize);
+        memcpy(head.data(), "CKPB", 4);
+        Internal::putLittleEndian(head.data() + 4, Internal::bankVersion);
+        head[6] = Internal::BinaryTraits<domain_t>::tag;
+        head[7] = traits::tag;
+        Internal::putLittleEndian(head.data() + 8, static_cast<uint64_t>(count));
+
+        size_t offset = Internal::bankAlign(head.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t n = polynomials[i].coefficients().size();
+            unsigned char* entry = head.data() + Internal::bankHeaderSize + i*Internal::bankEntrySize;
+            Internal::putLittleEndian(entry, static_cast<uint64_t>(offset));
+            Internal::putLittleEndian(entry + 8, static_cast<uint64_t>(n));
+            offset = Internal::bankAlign(offset + n*traits::size);
+        }
+        out.write(reinterpret_cast<const char*>(head.data()), static_cast<streamsize>(head.size()));
+
+        size_t position = head.size();
+        vector<unsigned char> bytes;
+        for (const Polynomial<domain_t, range_t>& poly : polynomials)
+        {
+            const vector<range_t>& coeffs = poly.coefficients();
+            const size_t start = Internal::bankAlign(position);
+            bytes.assign(start - position + coeffs.size()*traits::size, 0);
+            unsigned char* dest = bytes.data() + (start - position);
+            for (size_t k = 0; k < coeffs.size(); ++k)
+                traits::put(dest + k*traits::size, coeffs[k]);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+            position += bytes.size();
+        }
+
+        if (!out)
+            throw runtime_error("Failure writing polynomial bank.");
+    }
+
+
+    /// @brief A read-only collection of polynomials loaded from a file written by #writePolynomialBank.
+    /// @remarks
+    /// When `COSINEKITTY_ENABLE_MMAP` is defined before including this header on a POSIX system,
+    /// the file is mapped into memory, so opening it takes constant time
+    /// no matter how many coefficients it holds, pages are read only when they are used,
+    /// and several processes that open the same file share one copy in the page cache.
+    /// Each polynomial is returned as a `PolynomialView` that evaluates directly
+    /// from the mapped pages.
+    /// Otherwise the file is read into memory instead.
+    /// The views remain valid for the lifetime of the bank.
+    /// Requires a little-endian host.
+    /// @tparam domain_t The numeric type of the independent variable `x`.
+    /// @tparam range_t The numeric type of the polynomials' values.
+    template<typename domain_t, typename range_t>
+    class PolynomialBank
+    {
+    private:
+        using traits = Internal::BinaryTraits<range_t>;
+        static_assert(sizeof(range_t) == traits::size, "PolynomialBank requires range_t to match its stored size.");
+
+        const unsigned char* base = nullptr;
+        std::size_t length = 0;
+        std::size_t count = 0;
+#ifdef COSINEKITTY_USE_MMAP
+        void* mapping = nullptr;
+#else
+        std::vector<unsigned char, AlignedAllocator<unsigned char, Internal::bankAlignment>> buffer;
+#endif
+
+        void release()
+        {
+#ifdef COSINEKITTY_USE_MMAP
+            if (mapping != nullptr)
+                ::munmap(mapping, length);
+            mapping = nullptr;
+#endif
+        }
+
+        void load(const std::string& filename)
+        {
+            using namespace std;
+#ifdef COSINEKITTY_USE_MMAP
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw runtime_error("Cannot open polynomial bank: " + filename);
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < Internal::bankHeaderSize)
+            {
+                ::close(fd);
+                throw runtime_error("Polynomial bank is truncated: " + filename);
+            }
+            length = static_cast<size_t>(info.st_size);
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (address == MAP_FAILED)
+                throw runtime_error("Cannot map polynomial bank: " + filename);
+            mapping = address;
+            base = static_cast<const unsigned char*>(address);
+#else
+            ifstream in(filename, ios::binary);
+            if (!in)
+                throw runtime_error("Cannot open polynomial bank: " + filename);
+            in.seekg(0, ios::end);
+            length = static_cast<size_t>(in.tellg());
+            in.seekg(0, ios::beg);
+            buffer.resize(length);
+            if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<streamsize>(length)) || length < Internal::bankHeaderSize)
+                throw runtime_error("Polynomial bank is truncated: " + filename);
+            base = buffer.data();
+#endif
+        }
+
+    public:
+        /// @brief Opens a polynomial bank file.
+        /// @remarks
+        /// Only the header is checked when the file is opened.
+        /// Each table entry is checked when its polynomial is accessed.
+        /// Throws `std::runtime_error` if the file cannot be read, is not a polynomial bank,
+        /// holds different numeric types, or the host is not little-endian.
+        /// @param filename The path of a file written by #writePolynomialBank.
+        explicit PolynomialBank(const std::string& filename)
+        {
+            using namespace std;
+            if (!Internal::hostIsLittleEndian())
+                throw runtime_error("PolynomialBank requires a little-endian host.");
+
+            load(filename);
+            const char* problem = nullptr;
+            if (memcmp(base, "CKPB", 4) != 0)
+                problem = "File is not a polynomial bank: ";
+            else if (Internal::getLittleEndian<uint16_t>(base + 4) != Internal::bankVersion)
+                problem = "Polynomial bank has an unsupported version: ";
+            else if (base[6] != Internal::BinaryTraits<domain_t>::tag || base[7] != traits::tag)
+                problem = "Polynomial bank holds different numeric types: ";
+            else
+            {
+                const uint64_t n = Internal::getLittleEndian<uint64_t>(base + 8);
+                if (n > (length - Internal::bankHeaderSize) / Internal::bankEntrySize)
+                    problem = "Polynomial bank is truncated: ";
+                else
+                    count = static_cast<size_t>(n);
+            }
+
+            if (problem != nullptr)
+            {
+                release();
+                throw runtime_error(problem + filename);
+            }
+        }
+
+        ~PolynomialBank()
+        {
+            release();
+        }
+
+        PolynomialBank(const PolynomialBank&) = delete;
+        PolynomialBank& operator = (const PolynomialBank&) = delete;
+
+        /// @brief Returns the number of polynomials in the bank.
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /// @brief Returns a view of one polynomial in the bank, without copying its coefficients.
+        /// @remarks
+        /// Throws `std::out_of_range` if the index is too large, or `std::runtime_error`
+        /// if the table entry refers to memory outside the file.
+        /// @param index A value in the range `0` to `size()-1`.
+        /// @return A view that evaluates the polynomial directly from the file's memory.
+        PolynomialView<domain_t, range_t> operator[] (std::size_t index) const
+        {
+            using namespace std;
+            if (index >= count)
+                throw out_of_range("PolynomialBank index is out of range.");
+
+            const unsigned char* entry = base + Internal::bankHeaderSize + index*Internal::bankEntrySize;
+            const uint64_t offset = Internal::getLittleEndian<uint64_t>(entry);
+            const uint64_t n = Internal::getLittleEndian<uint64_t>(entry + 8);
+            if (offset > length || n > (length - offset) / traits::size || offset % alignof(range_t) != 0)
+                throw runtime_error("PolynomialBank table entry is invalid.");
+
+            return PolynomialView<domain_t, range_t>{reinterpret_cast<const range_t*>(base + offset), static_cast<size_t>(n)};
+        }
+    };
+
+
+
+    namespace Internal
+    {
+        constexpr std::size_t defaultLoadChunkSize = 65536;
+        constexpr std::size_t csvBlockSize = 1 << 20;
+
+        // Parses text lines of the form "x,y" and inserts the points into an interpolator
+        // in chunks, so memory use is bounded no matter how large the input is.
+        template<typename domain_t, typename range_t>
+        class CsvPointParser
+        {
+        private:
+            static_assert(std::is_floating_point<domain_t>::value && std::is_floating_point<range_t>::value, "CSV points must be real floating point values.");
+
+            Interpolator<domain_t, range_t>& interp;
+            const std::size_t start;        // the number of points before loading began
+            const std::size_t chunkSize;
+            std::vector<domain_t> xs;
+            std::vector<range_t> ys;
+            std::size_t line = 0;
+
+            static bool isBlank(char c)
+            {
+                return c == ' ' || c == '\t' || c == '\r';
+            }
+
+            template<typename real_t>
+            static const char* number(const char* first, const char* last, real_t& value)
+            {
+                while (first != last && isBlank(*first))
+                    ++first;
+                if (first != last && *first == '+')
+                    ++first;
+                const std::from_chars_result result = std::from_chars(first, last, value);
+                return (result.ec == std::errc{}) ? result.ptr : nullptr;
+            }
+
+            void parseLine(const char* first, const char* last)
+            {
+                ++line;
+                while (first != last && isBlank(*first))
+                    ++first;
+                if (first == last || *first == '#')
+                    return;
+
+                domain_t x;
+                range_t y;
+                const char* p = number(first, last, x);
+                if (p != nullptr)
+                {
+                    while (p != last && isBlank(*p))
+                        ++p;
+                    if (p != last && (*p == ',' || *p == ';'))
+                        ++p;
+                    p = number(p, last, y);
+                }
+                if (p != nullptr)
+                {
+                    while (p != last && isBlank(*p))
+                        ++p;
+                }
+
+                if (p == nullptr || p != last)
+                {
+                    if (line == 1)
+                        return;     // a column header line
+                    throw std::runtime_error("Invalid point on line " + std::to_string(line) + ".");
+                }
+                if (std::isnan(x))
+                    throw std::invalid_argument("NaN x value on line " + std::to_string(line) + ".");
+
+                xs.push_back(x);
+                ys.push_back(y);
+                if (xs.size() == chunkSize)
+                    flush();
+            }
+
+        public:
+            CsvPointParser(Interpolator<domain_t, range_t>& _interp, std::size_t _chunkSize)
+                : interp(_interp)
+                , start(_interp.size())
+                , chunkSize(std::max<std::size_t>(1, _chunkSize))
+            {
+                xs.reserve(chunkSize);
+                ys.reserve(chunkSize);
+            }
+
+            // Parses each complete line in [first, last). When `final` is set, the text
+            // after the last newline is parsed too. Returns the start of any unparsed text.
+            const char* parse(const char* first, const char* last, bool final)
+            {
+                for (;;)
+                {
+                    const char* end = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+                    if (end == nullptr)
+                        break;
+                    parseLine(first, end);
+                    first = end + 1;
+                }
+                if (final && first != last)
+                {
+                    parseLine(first, last);
+                    first = last;
+                }
+                return first;
+            }
+
+            // Appends any remaining points, then resolves duplicate x values
+            // among all the appended points at once.
+            std::size_t finish()
+            {
+                flush();
+                return interp.commit(start);
+            }
+
+            void flush()
+            {
+                interp.append(xs.data(), ys.data(), xs.size());
+                xs.clear();
+                ys.clear();
+            }
+        };
+
+        template<typename domain_t, typename range_t>
+        class BinaryPointDecoder
+        {
+        private:
+            using xtraits = BinaryTraits<domain_t>;
+            using ytraits = BinaryTraits<range_t>;
+
+            Interpolator<domain_t, range_t>& interp;
+            const std::size_t start;        // the number of points before loading began
+            std::vector<domain_t> xs;       // one chunk of decoded points
+            std::vector<range_t> ys;
+
+        public:
+            static constexpr std::size_t pointSize = xtraits::size + ytraits::size;
+
+            BinaryPointDecoder(Interpolator<domain_t, range_t>& _interp)
+                : interp(_interp)
+                , start(_interp.size())
+                {}
+
+            // Decodes a chunk of points and appends them to the interpolator.
+            // Duplicate x values are resolved once, by commit, after the last chunk.
+            void decode(const unsigned char* bytes, std::size_t count)
+            {
+                xs.resize(count);
+                ys.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    xs[i] = xtraits::get(bytes + i*pointSize);
+                    ys[i] = ytraits::get(bytes + i*pointSize + xtraits::size);
+                }
+                interp.append(xs.data(), ys.data(), count);
+            }
+
+            std::size_t commit()
+            {
+                return interp.commit(start);
+            }
+
+            void rollback()
+            {
+                interp.rollback(start);
+            }
+        };
+    }
+
+
+    /// @brief Reads text points `x,y` from a stream and inserts them into an interpolator.
+    /// @remarks
+    /// Each line holds one point: two numbers separated by a comma, a semicolon, or blanks.
+    /// Blank lines and lines starting with `#` are ignored, as is a first line that
+    /// does not hold two numbers, such as column headings.
+    /// The text is read in fixed-size blocks and the points are appended to the interpolator
+    /// in chunks, so apart from the interpolator's own storage, memory use stays bounded
+    /// no matter how large the input is.
+    /// Numbers are parsed with `std::from_chars`, independent of the current locale.
+    /// As with `Interpolator::insert`, points whose `x` value was already inserted are skipped;
+    /// duplicates are found once for the whole load, in O(m*log(n)) for m new points.
+    /// Throws `std::runtime_error` on a line that cannot be parsed, and `std::invalid_argument`
+    /// on a NaN `x` value; points before the line remain inserted.
+    /// Both `domain_t` and `range_t` must be real floating point types.
+    /// @param in The stream that supplies the text.
+    /// @param interp The interpolator that receives the points.
+    /// @param chunkSize The number of points to parse before inserting them.
+    /// @return The number of points inserted.
+    template<typename domain_t, typename range_t>
+    std::size_t loadCsvPoints(std::istream& in, Interpolator<domain_t, range_t>& interp, std::size_t chunkSize = Internal::defaultLoadChunkSize)
+    {
+        Internal::CsvPointParser<domain_t, range_t> parser(interp, chunkSize);
+        std::vector<char> block(Internal::csvBlockSize);
+        std::size_t pending = 0;
+        try
+        {
+            for (;;)
+            {
+                if (pending == block.size())
+                    throw std::runtime_error("CSV line is too long.");
+                in.read(block.data() + pending, static_cast<std::streamsize>(block.size() - pending));
+                const std::size_t length = pending + static_cast<std::size_t>(in.gcount());
+                const bool final = !in;
+                const char* rest = parser.parse(block.data(), block.data() + length, final);
+                if (final)
+                    break;
+                pending = static_cast<std::size_t>(block.data() + length - rest);
+                std::memmove(block.data(), rest, pending);
+            }
+        }
+        catch (...)
+        {
+            parser.finish();    // keep the points before the problem
+            throw;
+        }
+        return parser.finish();
+    }
+
+
+    /// @brief Parses text points `x,y` from memory and inserts them into an interpolator.
+    /// @remarks
+    /// Works the same as the stream version, but parses directly from the supplied memory,
+    /// for example a file mapped into memory, without copying the text.
+    /// @param data The start of the text.
+    /// @param size The number of bytes of text.
+    /// @param interp The interpolator that receives the points.
+    /// @param chunkSize The number of points to parse before inserting them.
+    /// @return The number of points inserted.
+    template<typename domain_t, typename range_t>
+    std::size_t loadCsvPoints(const char* data, std::size_t size, Interpolator<domain_t, range_t>& interp, std::size_t chunkSize = Internal::defaultLoadChunkSize)
+    {
+        Internal::CsvPointParser<domain_t, range_t> parser(interp, chunkSize);
+        try
+        {
+            parser.parse(data, data + size, true);
+        }
+        catch (...)
+        {
+            parser.finish();    // keep the points before the problem
+            throw;
+        }
+        return parser.finish();
+    }
+
+
+    /// @brief Reads binary points written by #writeBinary and inserts them into an interpolator.
+    /// @remarks
+    /// Unlike #readInterpolator, the points are added to any points already in the interpolator.
+    /// The raw bytes are read and decoded in chunks and appended straight to the interpolator,
+    /// so apart from the interpolator's own storage, memory use stays bounded.
+    /// Points whose `x` value was already inserted are skipped; duplicates are found once
+    /// for the whole load, in O(m*log(n)) for m new points.
+    /// If the stream can seek, a first pass verifies the checksum of the whole payload
+    /// and a second pass decodes it, so if an exception is thrown the interpolator is unchanged.
+    /// A stream that cannot seek, such as a pipe, is read only once: each chunk is appended
+    /// as it arrives, so if the data turns out to be truncated or fails its checksum,
+    /// the points before the problem remain inserted, as with #loadCsvPoints.
+    /// Throws `std::runtime_error` if the data is truncated, fails its checksum,
+    /// or was written for a different object or numeric types,
+    /// and `std::invalid_argument` if a real-valued `x` is NaN.
+    /// @param in The stream that supplies the binary data. It should be opened in binary mode.
+    /// @param interp The interpolator that receives the points.
+    /// @param chunkSize The number of points to read and decode at a time.
+    /// @return The number of points inserted.
+    template<typename domain_t, typename range_t>
+    std::size_t loadBinaryPoints(std::istream& in, Interpolator<domain_t, range_t>& interp, std::size_t chunkSize = Internal::defaultLoadChunkSize)
+    {
+        using namespace std;
+        using decoder_t = Internal::BinaryPointDecoder<domain_t, range_t>;
+
+        unsigned char head[Internal::binaryHeaderSize];
+        if (!in.read(reinterpret_cast<char*>(head), Internal::binaryHeaderSize))
+            throw runtime_error("Binary data is truncated.");
+        const Internal::BinaryHeader header = Internal::decodeHeader<domain_t, range_t>(head, Internal::binaryKindPoints);
+
+        chunkSize = max<size_t>(1, chunkSize);
+        vector<unsigned char> bytes(static_cast<size_t>(min<uint64_t>(header.count, chunkSize)) * decoder_t::pointSize);
+        auto readChunk = [&](size_t n)
+        {
+            if (!in.read(reinterpret_cast<char*>(bytes.data()), static_cast<streamsize>(n * decoder_t::pointSize)))
+                throw runtime_error("Binary data is truncated.");
+        };
+
+        decoder_t decoder(interp);
+        const streampos payload = in.tellg();
+        if (payload != streampos(-1))
+        {
+            uint64_t hash = Internal::fnv1aBasis;
+            for (uint64_t remaining = header.count; remaining > 0; )
+            {
+                const size_t n = static_cast<size_t>(min<uint64_t>(remaining, chunkSize));
+                readChunk(n);
+                hash = Internal::fnv1a(bytes.data(), n * decoder_t::pointSize, hash);
+                remaining -= n;
+            }
+            if (hash != header.checksum)
+                throw runtime_error("Binary data checksum does not match.");
+            if (!in.seekg(payload))
+                throw runtime_error("Binary stream could not be rewound.");
+
+            try
+            {
+                for (uint64_t remaining = header.count; remaining > 0; )
+                {
+                    const size_t n = static_cast<size_t>(min<uint64_t>(remaining, chunkSize));
+                    readChunk(n);
+                    decoder.decode(bytes.data(), n);
+                    remaining -= n;
+                }
+            }
+            catch (...)
+            {
+                decoder.rollback();
+                throw;
+            }
+            return decoder.commit();
+        }
+
+        uint64_t hash = Internal::fnv1aBasis;
+        try
+        {
+            for (uint64_t remaining = header.count; remaining > 0; )
+            {
+                const size_t n = static_cast<size_t>(min<uint64_t>(remaining, chunkSize));
+                readChunk(n);
+                hash = Internal::fnv1a(bytes.data(), n * decoder_t::pointSize, hash);
+                decoder.decode(bytes.data(), n);
+                remaining -= n;
+            }
+        }
+        catch (...)
+        {
+            decoder.commit();   // keep the points before the problem
+            throw;
+        }
+        const size_t inserted = decoder.commit();
+        if (hash != header.checksum)
+            throw runtime_error("Binary data checksum does not match.");
+        return inserted;
+    }
+
+
+    /// @brief Decodes binary points written by #writeBinary from memory and inserts them into an interpolator.
+    /// @remarks
+    /// Works the same as the stream version, but decodes directly from the supplied memory,
+    /// for example a file mapped into memory, without copying the raw bytes.
+    /// The checksum of the whole payload is verified before anything is decoded,
+    /// so if an exception is thrown the interpolator is unchanged.
+    /// @param data The start of the binary data.
+    /// @param size The number of bytes available at `data`.
+    /// @param interp The interpolator that receives the points.
+    /// @param chunkSize The number of points to decode at a time.
+    /// @return The number of points inserted.
+    template<typename domain_t, typename range_t>
+    std::size_t loadBinaryPoints(const void* data, std::size_t size, Interpolator<domain_t, range_t>& interp, std::size_t chunkSize = Internal::defaultLoadChunkSize)
+    {
+        using namespace std;
+        using decoder_t = Internal::BinaryPointDecoder<domain_t, range_t>;
+
+        if (size < Internal::binaryHeaderSize)
+            throw runtime_error("Binary data is truncated.");
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        const Internal::BinaryHeader header = Internal::decodeHeader<domain_t, range_t>(bytes, Internal::binaryKindPoints);
+        if (header.count > (size - Internal::binaryHeaderSize) / decoder_t::pointSize)
+            throw runtime_error("Binary data is truncated.");
+
+        const unsigned char* payload = bytes + Internal::binaryHeaderSize;
+        const size_t count = static_cast<size_t>(header.count);
+        if (Internal::fnv1a(payload, count * decoder_t::pointSize) != header.checksum)
+            throw runtime_error("Binary data checksum does not match.");
+
+        decoder_t decoder(interp);
+        chunkSize = max<size_t>(1, chunkSize);
+        try
+        {
+            const unsigned char* p = payload;
+            for (size_t remaining = count; remaining > 0; )
+            {
+                const size_t n = min(remaining, chunkSize);
+                decoder.decode(p, n);
+                p += n * decoder_t::pointSize;
+                remaining -= n;
+            }
+        }
+        catch (...)
+        {
+            decoder.rollback();
+            throw;
+        }
+        return decoder.commit();
+    }
 };
 
 #endif // __COSINEKITTY_INTERPOLATOR_HPP
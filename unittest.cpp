@@ -1,9 +1,15 @@
+#define COSINEKITTY_ENABLE_MMAP
 #include "interpolator.hpp"
 #include <cstdio>
 #include <cmath>
 #include <complex>
 #include <string>
 #include <functional>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
 
 using float_poly_t  = CosineKitty::Polynomial<float, float>;
 using double_poly_t = CosineKitty::Polynomial<double, double>;
@@ -115,6 +121,25 @@ bool CompareCoeffs(
 }
 
 
+template <typename exception_t, typename action_t>
+bool ExpectThrow(const char *caller, const char *what, action_t action, const char *message = nullptr)
+{
+    try
+    {
+        action();
+    }
+    catch (const exception_t& e)
+    {
+        if (message == nullptr || std::string(e.what()).find(message) != std::string::npos)
+            return true;
+        printf("%s: FAIL: %s threw the wrong error: %s\n", caller, what, e.what());
+        return false;
+    }
+    printf("%s: FAIL: %s did not throw.\n", caller, what);
+    return false;
+}
+
+
 static bool PolynomialMult()
 {
     // Create a simple binomial.
@@ -280,6 +305,382 @@ static bool PolynomialUnary()
 }
 
 
+static double PseudoRandom(unsigned& state)
+{
+    // A tiny linear congruential generator, so that tests are repeatable on any platform.
+    state = 1664525u*state + 1013904223u;
+    return (state >> 8) / 8388608.0 - 1.0;
+}
+
+
+static bool PolynomialDivide()
+{
+    // (x^3 - 2x^2 - 4) / (x - 3) = (x^2 + x + 3), remainder 5.
+    double_poly_t a {-4, 0, -2, 1};
+    double_poly_t b {-3, 1};
+    auto qr = a.divmod(b);
+    double_poly_t q = a / b;
+    double_poly_t r = a % b;
+
+    if (!CompareCoeffs(__func__, qr.first.coefficients(), {3.0, 1.0, 1.0})) return false;
+    if (!CompareCoeffs(__func__, qr.second.coefficients(), {5.0})) return false;
+    if (!CompareCoeffs(__func__, q.coefficients(), {3.0, 1.0, 1.0})) return false;
+    if (!CompareCoeffs(__func__, r.coefficients(), {5.0})) return false;
+
+    // Dividing by a higher-degree polynomial leaves the dividend as the remainder.
+    if (!(b / a).isZero()) return false;
+    if (!CompareCoeffs(__func__, (b % a).coefficients(), b.coefficients())) return false;
+
+    if (!ExpectThrow<std::domain_error>(__func__, "division by the zero polynomial", [&]() { a /= double_poly_t{}; })) return false;
+
+    // Build a large problem that exercises the Newton iteration path.
+    unsigned state = 12345;
+    std::vector<double> qc, dc, rc;
+    for (int i = 0; i < 300; ++i)
+        qc.push_back(PseudoRandom(state));
+    for (int i = 0; i < 200; ++i)
+        dc.push_back(0.01 * PseudoRandom(state));
+    dc.push_back(1.0);
+    for (int i = 0; i < 200; ++i)
+        rc.push_back(PseudoRandom(state));
+
+    double_poly_t bigQ {qc};
+    double_poly_t bigD {dc};
+    double_poly_t bigR {rc};
+    double_poly_t bigA = bigQ*bigD + bigR;
+    auto big = bigA.divmod(bigD);
+
+    return (
+        CompareCoeffs(__func__, big.first.coefficients(), qc, 1.0e-12) &&
+        CompareCoeffs(__func__, big.second.coefficients(), rc, 1.0e-12) &&
+        Pass(__func__)
+    );
+}
+
+
+struct SerialExecutor
+{
+    // A minimal executor that runs every chunk on the calling thread.
+    std::size_t chunks = 0;
+
+    void parallelFor(std::size_t count, std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& func)
+    {
+        for (std::size_t begin = 0; begin < count; begin += grainSize)
+        {
+            func(begin, std::min(count, begin + grainSize));
+            ++chunks;
+        }
+    }
+};
+
+
+static bool PolynomialBatchEvaluate()
+{
+    using namespace CosineKitty;
+
+    double_poly_t poly {0.5, -1.25, 3.0, 0.75, -0.125};
+    const std::size_t count = 100003;
+    std::vector<double> x(count);
+    for (std::size_t i = 0; i < count; ++i)
+        x[i] = -2.0 + 4.0*i/count;
+
+    std::vector<double> serial(count);
+    poly.evaluate(x.data(), serial.data(), count);
+    for (std::size_t i = 0; i < count; i += 997)
+        if (!Check(__func__, x[i], poly(x[i]), serial[i], 1.0e-14)) return false;
+
+    ParallelOptions options;
+    options.threadCount = 4;
+    options.grainSize = 1000;
+    std::vector<double> parallel(count);
+    poly.evaluate(x.data(), parallel.data(), count, options);
+    if (!CompareCoeffs(__func__, parallel, serial)) return false;
+
+    WorkStealingPool pool(3);
+    std::vector<double> pooled(count);
+    poly.evaluate(x.data(), pooled.data(), count, pool);
+    poly.evaluate(x.data(), pooled.data(), count, pool, 17);   // reuse the same pool
+    if (!CompareCoeffs(__func__, pooled, serial)) return false;
+
+    SerialExecutor executor;
+    std::vector<double> external(count);
+    poly.evaluate(x.data(), external.data(), count, executor, 10000);
+    if (executor.chunks != 11)
+    {
+        printf("%s: FAIL: expected 11 chunks, found %u\n", __func__, static_cast<unsigned>(executor.chunks));
+        return false;
+    }
+    if (!CompareCoeffs(__func__, external, serial)) return false;
+
+    // Exceptions thrown by a chunk must reach the caller.
+    auto failingChunk = [](std::size_t begin, std::size_t end)
+    {
+        if (begin <= 500 && 500 < end)
+            throw std::runtime_error("chunk failure");
+    };
+    if (!ExpectThrow<std::runtime_error>(__func__, "failing chunk", [&]() { pool.parallelFor(1000, 10, failingChunk); })) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool ChebyshevBasics()
+{
+    using namespace CosineKitty;
+    using series_t = ChebyshevSeries<double, double>;
+
+    // T2(u) = 2u^2 - 1.
+    series_t t2 {{0.0, 0.0, 1.0}};
+    if (!Check(__func__, 0.5, -0.5, t2(0.5), 1.0e-15)) return false;
+
+    // Interpolate exp(x) on [0, 2], using both the FFT path (16 nodes) and direct path (15 nodes).
+    for (std::size_t n : {16, 15})
+    {
+        series_t f = series_t::interpolate([](double x){ return std::exp(x); }, n, 0.0, 2.0);
+        series_t df = f.derivative();
+        series_t F = f.integral(1.0);
+
+        std::vector<double> xs, ys(201);
+        for (int i = 0; i <= 200; ++i)
+            xs.push_back(0.01 * i);
+        f.evaluate(xs.data(), ys.data(), xs.size());
+
+        for (std::size_t i = 0; i < xs.size(); i += 5)
+        {
+            const double x = xs[i];
+            if (!Check(__func__, x, std::exp(x), f(x), 1.0e-14)) return false;
+            if (!Check(__func__, x, f(x), ys[i], 1.0e-15)) return false;
+            if (!Check(__func__, x, std::exp(x), df(x), 1.0e-12)) return false;
+            if (!Check(__func__, x, std::exp(x), F(x), 1.0e-14)) return false;
+        }
+    }
+
+    // The nodes are where the interpolated values are reproduced.
+    std::vector<double> nodes = series_t::nodes(8, -3.0, 5.0);
+    std::vector<double> values;
+    for (double x : nodes)
+        values.push_back(x*x*x - x);
+    series_t cubic = series_t::fromNodeValues(values, -3.0, 5.0);
+    for (double x = -3.0; x <= 5.0; x += 0.5)
+        if (!Check(__func__, x, x*x*x - x, cubic(x), 1.0e-12)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PolynomialReduceDegree()
+{
+    using namespace CosineKitty;
+
+    // Taylor series of exp(x) to degree 12.
+    std::vector<double> taylor;
+    double term = 1.0;
+    for (int k = 0; k <= 12; ++k)
+    {
+        taylor.push_back(term);
+        term /= (k + 1);
+    }
+    double_poly_t poly {taylor};
+
+    // Converting to a Chebyshev series and back reproduces the polynomial.
+    double_poly_t roundTrip = ChebyshevSeries<double, double>::fromPolynomial(poly, -2.0, 3.0).toPolynomial();
+    if (!CompareCoeffs(__func__, roundTrip.coefficients(), poly.coefficients(), 1.0e-12)) return false;
+
+    const double tolerance = 1.0e-6;
+    double_poly_t reduced = poly.reduceDegree(tolerance, -1.0, +1.0);
+    const std::size_t degree = reduced.coefficients().size() - 1;
+    printf("%s: reduced degree 12 to %u\n", __func__, static_cast<unsigned>(degree));
+    if (degree > 8)
+    {
+        printf("%s: FAIL: degree was not reduced enough.\n", __func__);
+        return false;
+    }
+
+    double maxdiff = 0.0;
+    for (double x = -1.0; x <= 1.0; x += 0.001)
+        maxdiff = std::max(maxdiff, std::abs(reduced(x) - poly(x)));
+    if (!Check(__func__, 0.0, 0.0, maxdiff, tolerance)) return false;
+
+    // A generous tolerance reduces a polynomial all the way to zero.
+    if (!double_poly_t{0.001, 0.002}.reduceDegree(1.0, 0.0, 1.0).isZero()) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PolynomialMinimax()
+{
+    using namespace CosineKitty;
+
+    auto func = [](double x) { return std::exp(x); };
+    const double a = 0.0;
+    const double b = 1.0;
+    const std::size_t degree = 4;
+
+    double error;
+    double_poly_t best = minimax(func, a, b, degree, &error);
+    if (best.coefficients().size() != degree + 1)
+    {
+        printf("%s: FAIL: wrong degree.\n", __func__);
+        return false;
+    }
+    printf("%s: degree %u minimax error = %g\n", __func__, static_cast<unsigned>(degree), error);
+
+    // The reported error matches the actual largest error.
+    double maxdiff = 0.0;
+    for (double x = a; x <= b; x += 0.0001)
+        maxdiff = std::max(maxdiff, std::abs(best(x) - func(x)));
+    if (!Check(__func__, 0.0, maxdiff, error, 1.0e-3 * error)) return false;
+
+    // The minimax polynomial beats interpolation at the Chebyshev nodes.
+    ChebyshevSeries<double, double> cheb = ChebyshevSeries<double, double>::interpolate(func, degree + 1, a, b);
+    double chebdiff = 0.0;
+    for (double x = a; x <= b; x += 0.0001)
+        chebdiff = std::max(chebdiff, std::abs(cheb(x) - func(x)));
+    if (!(maxdiff < chebdiff))
+    {
+        printf("%s: FAIL: minimax error %g is not below Chebyshev error %g\n", __func__, maxdiff, chebdiff);
+        return false;
+    }
+
+    // Ask for the lowest degree that meets a tolerance.
+    const double tolerance = 1.0e-9;
+    double_poly_t fit = minimaxForTolerance(func, a, b, tolerance, 20, &error);
+    const std::size_t fitDegree = fit.coefficients().size() - 1;
+    if (error > tolerance)
+    {
+        printf("%s: FAIL: error %g exceeds tolerance.\n", __func__, error);
+        return false;
+    }
+    minimax(func, a, b, fitDegree - 1, &error);
+    if (error <= tolerance)
+    {
+        printf("%s: FAIL: degree %u was not minimal.\n", __func__, static_cast<unsigned>(fitDegree));
+        return false;
+    }
+
+    // A polynomial approximates itself exactly.
+    double_poly_t cubic {1.0, -2.0, 0.5, 3.0};
+    double_poly_t same = minimax([&](double x) { return cubic(x); }, -1.0, 2.0, 3);
+    if (!CompareCoeffs(__func__, same.coefficients(), cubic.coefficients(), 1.0e-12)) return false;
+
+    if (!ExpectThrow<std::range_error>(__func__, "unreachable tolerance", [&]() { minimaxForTolerance(func, a, b, 1.0e-20, 3); })) return false;
+
+    // A step function has no equioscillating error, so the exchange cannot converge.
+    auto step = [](double x) { return (x < 0.3) ? -1.0 : 1.0; };
+    if (!ExpectThrow<ConvergenceError>(__func__, "discontinuous function", [&]() { minimax(step, -1.0, 1.0, 5); })) return false;
+
+    // When searching for a degree, one that does not converge is skipped, not fatal.
+    bool failedOnce = false;
+    auto flaky = [&](double x) -> double
+    {
+        if (!failedOnce)
+        {
+            failedOnce = true;
+            throw ConvergenceError("simulated failure at degree 0");
+        }
+        return func(x);
+    };
+    double flakyError;
+    double_poly_t flakyFit = minimaxForTolerance(flaky, a, b, tolerance, 20, &flakyError);
+    if (!CompareCoeffs(__func__, flakyFit.coefficients(), fit.coefficients(), 0.0)) return false;
+
+    // If no degree meets the tolerance and some did not converge, that is reported instead.
+    if (!ExpectThrow<ConvergenceError>(__func__, "unconverged search", [&]() { minimaxForTolerance(step, -1.0, 1.0, 0.5, 5); })) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool CompareRoots(const char *caller, const std::vector<std::complex<double>>& found, const std::vector<std::complex<double>>& expected, double tolerance)
+{
+    if (found.size() != expected.size())
+    {
+        printf("%s: FAIL: found %u roots, expected %u\n", caller, static_cast<unsigned>(found.size()), static_cast<unsigned>(expected.size()));
+        return false;
+    }
+    // Match each expected root with the nearest root not matched yet,
+    // because nearly equal real parts may sort in either order.
+    std::vector<bool> used(found.size(), false);
+    for (const std::complex<double>& root : expected)
+    {
+        std::size_t best = found.size();
+        for (std::size_t i = 0; i < found.size(); ++i)
+            if (!used[i] && (best == found.size() || std::abs(found[i] - root) < std::abs(found[best] - root)))
+                best = i;
+        used[best] = true;
+        if (std::abs(found[best] - root) > tolerance)
+        {
+            printf("%s: FAIL: no root found near (%lf, %lf)\n", caller, root.real(), root.imag());
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static bool PolynomialRoots()
+{
+    using namespace CosineKitty;
+    using complex_t = std::complex<double>;
+
+    // (x - 1)(x - 2)(x + 3)(x^2 + 1), with real coefficients.
+    double_poly_t poly = double_poly_t{-1.0, 1.0} * double_poly_t{-2.0, 1.0} * double_poly_t{3.0, 1.0} * double_poly_t{1.0, 0.0, 1.0};
+    if (!CompareRoots(__func__, poly.roots(), {{-3.0, 0.0}, {0.0, -1.0}, {0.0, 1.0}, {1.0, 0.0}, {2.0, 0.0}}, 1.0e-12)) return false;
+
+    // Roots at zero are factored out exactly.
+    if (!CompareRoots(__func__, double_poly_t{0.0, 0.0, -5.0, 1.0}.roots(), {{0.0, 0.0}, {0.0, 0.0}, {5.0, 0.0}}, 0.0)) return false;
+    if (!double_poly_t{4.0}.roots().empty()) return false;
+
+    // Complex coefficients: (x - (1+2i))(x - (-0.5i)).
+    Polynomial<complex_t, complex_t> cpoly = Polynomial<complex_t, complex_t>{complex_t{-1.0, -2.0}, 1.0} * Polynomial<complex_t, complex_t>{complex_t{0.0, 0.5}, 1.0};
+    if (!CompareRoots(__func__, cpoly.roots(), {{0.0, -0.5}, {1.0, 2.0}}, 1.0e-12)) return false;
+
+    // Wilkinson's polynomial with roots 1..10 is badly conditioned, but still resolved.
+    double_poly_t wilkinson {1.0};
+    std::vector<complex_t> expected;
+    for (int k = 1; k <= 10; ++k)
+    {
+        wilkinson *= double_poly_t{-static_cast<double>(k), 1.0};
+        expected.push_back(complex_t{static_cast<double>(k), 0.0});
+    }
+    if (!CompareRoots(__func__, wilkinson.roots(), expected, 1.0e-6)) return false;
+
+    // Batches of quadratics agree with the quadratic formula, with any number of threads.
+    std::vector<double_poly_t> batch;
+    unsigned state = 99;
+    for (int i = 0; i < 200; ++i)
+        batch.push_back(double_poly_t{PseudoRandom(state), PseudoRandom(state), 1.0 + PseudoRandom(state)*0.5});
+    WorkStealingPool pool(4);
+    const auto pooled = roots(batch, pool, 8);
+    ParallelOptions options;
+    options.threadCount = 3;
+    const auto threaded = roots(batch, options);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const std::vector<double>& c = batch[i].coefficients();
+        const complex_t disc = std::sqrt(complex_t{c[1]*c[1] - 4.0*c[2]*c[0]});
+        const std::vector<complex_t> formula = {(-c[1] - disc) / (2.0*c[2]), (-c[1] + disc) / (2.0*c[2])};
+        if (!CompareRoots(__func__, pooled[i], formula, 1.0e-9)) return false;
+        if (pooled[i] != threaded[i])
+        {
+            printf("%s: FAIL: batch results depend on threading.\n", __func__);
+            return false;
+        }
+    }
+
+    // A triple root is only resolved to about the cube root of machine precision,
+    // but the iteration still settles once p(z) reaches the rounding level.
+    double_poly_t triple = double_poly_t{-1.0, 1.0}.pow(3) * double_poly_t{2.0, 1.0};
+    if (!CompareRoots(__func__, triple.roots(), {{-2.0, 0.0}, {1.0, 0.0}, {1.0, 0.0}, {1.0, 0.0}}, 1.0e-4)) return false;
+
+    if (!ExpectThrow<std::runtime_error>(__func__, "too few iterations", [&]() { wilkinson.roots(2); })) return false;
+    if (!ExpectThrow<std::domain_error>(__func__, "zero polynomial", [&]() { double_poly_t{}.roots(); })) return false;
+
+    return Pass(__func__);
+}
+
+
 static bool InterpTestDouble()
 {
     using namespace CosineKitty;
@@ -336,84 +737,1197 @@ static bool InterpTestComplex()
 }
 
 
-static bool FailDuplicate()
+static bool InterpParallel()
 {
-    CosineKitty::Interpolator<double, double> interp;
+    using namespace CosineKitty;
 
-    if (!interp.insert(3.0, 4.0))
+    Interpolator<double, double> interp;
+    for (int i = 0; i < 12; ++i)
     {
-        printf("%s: should have inserted first point.\n", __func__);
+        double x = 0.5*i - 3.0;
+        interp.insert(x, std::cos(3.0*x) + x);
+    }
+
+    double_poly_t serial = interp.polynomial();
+
+    ParallelOptions options;
+    options.threadCount = 4;
+    double_poly_t dynamic = interp.polynomial(options);
+
+    options.deterministic = true;
+    double_poly_t det4 = interp.polynomial(options);
+    double_poly_t det4again = interp.polynomial(options);
+    options.threadCount = 3;
+    double_poly_t det3 = interp.polynomial(options);
+
+    // Deterministic mode must produce identical results regardless of thread count.
+    if (!CompareCoeffs(__func__, det4.coefficients(), det4again.coefficients())) return false;
+    if (!CompareCoeffs(__func__, det4.coefficients(), det3.coefficients())) return false;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        double x = 0.5*i - 3.0;
+        double y = std::cos(3.0*x) + x;
+        if (!Check(__func__, x, y, serial(x), 1.0e-9)) return false;
+        if (!Check(__func__, x, y, dynamic(x), 1.0e-9)) return false;
+        if (!Check(__func__, x, y, det3(x), 1.0e-9)) return false;
+    }
+
+    // An empty interpolator produces the zero polynomial in parallel mode too.
+    Interpolator<double, double> empty;
+    if (!empty.polynomial(options).isZero()) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool InterpPiecewise()
+{
+    using namespace CosineKitty;
+
+    // Insert points on a uniform grid, in scrambled order.
+    Interpolator<double, double> uniformInterp;
+    const int n = 41;
+    for (int k = 0; k < n; ++k)
+    {
+        const int i = (k * 17) % n;
+        const double x = 0.25 * i;
+        uniformInterp.insert(x, std::sin(x));
+    }
+
+    PiecewisePolynomial<double, double> pw = uniformInterp.piecewise(4);
+    if (!pw.isUniform() || pw.segmentCount() != n-1 || pw.coefficientsPerSegment() != 4)
+    {
+        printf("%s: FAIL: unexpected uniform table shape.\n", __func__);
         return false;
     }
 
-    if (interp.insert(3.0, 5.0))
+    if (reinterpret_cast<std::uintptr_t>(pw.coefficients().data()) % 64 != 0)
     {
-        printf("%s: should NOT have inserted second point.\n", __func__);
+        printf("%s: FAIL: coefficient table is not cache aligned.\n", __func__);
         return false;
     }
 
+    for (int i = 0; i < n; ++i)
+    {
+        const double x = 0.25 * i;
+        if (!Check(__func__, x, std::sin(x), pw(x), 1.0e-14)) return false;
+    }
+
+    std::vector<double> xs, ys, sorted;
+    for (double x = -0.5; x <= 10.5; x += 0.01)
+        xs.push_back(x);
+    ys.resize(xs.size());
+    sorted.resize(xs.size());
+    pw.evaluate(xs.data(), ys.data(), xs.size());
+    pw.evaluateSorted(xs.data(), sorted.data(), xs.size());
+    if (!CompareCoeffs(__func__, sorted, ys)) return false;
+    for (std::size_t i = 0; i < xs.size(); i += 10)
+    {
+        if (xs[i] >= 0.0 && xs[i] <= 10.0)
+            if (!Check(__func__, xs[i], std::sin(xs[i]), ys[i], 2.0e-4)) return false;
+    }
+
+    // Non-uniform breakpoints use binary search.
+    Interpolator<double, double> ragged;
+    for (int i = 0; i < n; ++i)
+    {
+        const double x = 0.1 * std::pow(i, 1.5);
+        ragged.insert(x, std::exp(-x));
+    }
+    PiecewisePolynomial<double, double> rp = ragged.piecewise(3);
+    if (rp.isUniform()) return false;
+    for (int i = 0; i < n; ++i)
+    {
+        const double x = 0.1 * std::pow(i, 1.5);
+        if (rp.segment(x) != static_cast<std::size_t>(std::min(i, n-2))) return false;
+        if (!Check(__func__, x, std::exp(-x), rp(x), 1.0e-14)) return false;
+    }
+
+    if (!ExpectThrow<std::invalid_argument>(__func__, "oversized window", [&]() { ragged.piecewise(n+1); })) return false;
+
     return Pass(__func__);
 }
 
 
-static double TestEval(std::function<double(double)> func, double x)
+static bool InterpSplines()
 {
-    return func(x);
+    using namespace CosineKitty;
+
+    Interpolator<double, double> interp;
+    std::vector<double> xs;
+    for (int i = 0; i < 25; ++i)
+    {
+        const double x = 0.3*i + 0.02*(i % 3);
+        xs.push_back(x);
+        interp.insert(x, std::sin(x));
+    }
+
+    PiecewisePolynomial<double, double> natural = interp.naturalSpline();
+    if (natural.coefficientsPerSegment() != 4) return false;
+    const auto& c = natural.coefficients();
+    const std::size_t segs = natural.segmentCount();
+
+    // The spline passes through the points, and its second derivative is zero at both ends.
+    for (double x : xs)
+        if (!Check(__func__, x, std::sin(x), natural(x), 1.0e-14)) return false;
+    const double hlast = xs.back() - xs[xs.size()-2];
+    if (!Check(__func__, xs[0], 0.0, 2*c[2], 1.0e-14)) return false;
+    if (!Check(__func__, xs.back(), 0.0, 2*c[4*segs-2] + 6*c[4*segs-1]*hlast, 1.0e-13)) return false;
+
+    // The first and second derivatives are continuous at interior breakpoints.
+    for (std::size_t s = 1; s < segs; ++s)
+    {
+        const double h = xs[s] - xs[s-1];
+        const double* p = &c[4*(s-1)];
+        const double* q = &c[4*s];
+        if (!Check(__func__, xs[s], q[1], p[1] + 2*p[2]*h + 3*p[3]*h*h, 1.0e-13)) return false;
+        if (!Check(__func__, xs[s], 2*q[2], 2*p[2] + 6*p[3]*h, 1.0e-12)) return false;
+    }
+
+    // Away from the ends, the spline is a good approximation.
+    for (double x = 1.5; x < 5.5; x += 0.05)
+        if (!Check(__func__, x, std::sin(x), natural(x), 1.0e-4)) return false;
+
+    // A monotone spline through step-like data must not overshoot.
+    Interpolator<double, double> steps;
+    const double sx[] = { 0.0, 1.0, 2.0, 2.5, 4.0, 5.0, 7.0 };
+    const double sy[] = { 0.0, 0.0, 1.0, 3.0, 3.1, 3.1, 5.0 };
+    for (int i = 0; i < 7; ++i)
+        steps.insert(sx[i], sy[i]);
+    PiecewisePolynomial<double, double> mono = steps.monotoneSpline();
+    double prev = mono(0.0);
+    for (double x = 0.0; x <= 7.0; x += 0.01)
+    {
+        const double y = mono(x);
+        if (y < prev - 1.0e-12)
+        {
+            printf("%s: FAIL: monotone spline decreased at x = %lf\n", __func__, x);
+            return false;
+        }
+        prev = y;
+    }
+    for (int i = 0; i < 7; ++i)
+        if (!Check(__func__, sx[i], sy[i], mono(sx[i]), 1.0e-14)) return false;
+
+    return Pass(__func__);
 }
 
 
-static bool PassAsFunction()
+static bool Contains(const char *caller, const std::string& text, const std::string& expected)
 {
-    // Verify that a polynomial can be passed as a C++ std::function,
-    // just like a lambda can.
-    double_poly_t poly {17.0, 5.0, -3.0};      // -3x^2 + 5x + 17
-    double yCalc = TestEval(poly, 2.0);
-    double yCorrect = -3.0*(2.0*2.0) + 5.0*(2.0) + 17.0;
-    double diff = std::abs(yCalc - yCorrect);
-    printf("%s: diff = %le\n", __func__, diff);
-    return Pass(__func__);
+    if (text.find(expected) == std::string::npos)
+    {
+        printf("%s: FAIL: generated code does not contain: %s\n", caller, expected.c_str());
+        return false;
+    }
+    return true;
 }
 
 
-static bool TruncateTrailingZeroCoeffs()
+static bool CodeGeneration()
 {
-    // It is wasteful to retain high-order coefficients that are zero.
-    // For example, [3, 7, 0, 0] represents f(x) = 0*x^3 + 0*x^2 + 7*x + 3.
-    // This should automatically be converted to [3, 7] = 7*x + 3.
-    // Test this in a yucky case where range_t is complex.
-    using range_t = std::complex<float>;
-    using poly_t = CosineKitty::Polynomial<float, range_t>;
+    using namespace CosineKitty;
 
-    poly_t poly {3, 7, 0, 0};
-    std::vector<range_t> check {3, 7};
+    double_poly_t poly {1.5, -2.0, 0.1, 3.0, 1.0/3.0};
+    CodeGenOptions options;
+    options.functionName = "fitted";
+    options.batch = true;
+
+    std::ostringstream horner;
+    generateCode(horner, poly, options);
+    const std::string hornerText = horner.str();
+    if (!Contains(__func__, hornerText, "#include <cmath>")) return false;
+    if (!Contains(__func__, hornerText, "inline constexpr double fitted_coefficients[5] =")) return false;
+    if (!Contains(__func__, hornerText, "inline double fitted(double x)")) return false;
+    if (!Contains(__func__, hornerText, "y = std::fma(y, x, c[0]);")) return false;
+    if (!Contains(__func__, hornerText, "inline void fitted_batch(const double* x, double* y, std::size_t count)")) return false;
+
+    // The coefficient literals read back as exactly the same values.
+    std::size_t pos = hornerText.find("=\n{\n");
+    const char *cursor = hornerText.c_str() + pos + 4;
+    for (double c : poly.coefficients())
+    {
+        char *end;
+        const double value = std::strtod(cursor, &end);
+        if (value != c)
+        {
+            printf("%s: FAIL: coefficient %.17g was written as %.17g\n", __func__, c, value);
+            return false;
+        }
+        cursor = end + 2;   // skip ",\n"
+    }
 
-    return (
-        CompareCoeffs(__func__, poly.coefficients(), check) &&
-        Pass(__func__)
-    );
+    options.scheme = EvaluationScheme::Estrin;
+    options.useFma = false;
+    options.batch = false;
+    options.preamble = false;
+    std::ostringstream estrin;
+    generateCode(estrin, poly, options);
+    const std::string estrinText = estrin.str();
+    if (!Contains(__func__, estrinText, "const double e0_1 = c[3]*x + c[2];")) return false;
+    if (!Contains(__func__, estrinText, "const double x4 = x2*x2;")) return false;
+    if (estrinText.find("#include") != std::string::npos || estrinText.find("_batch") != std::string::npos)
+    {
+        printf("%s: FAIL: unexpected preamble or batch function.\n", __func__);
+        return false;
+    }
+
+    // Piecewise polynomials carry their breakpoints and segment lookup.
+    CosineKitty::Interpolator<float, float> interp;
+    interp.insert(0.0f, 1.0f);
+    interp.insert(0.5f, 3.0f);
+    interp.insert(1.0f, 2.0f);
+    interp.insert(1.5f, 2.5f);
+    options = CodeGenOptions{};
+    options.functionName = "spline";
+    std::ostringstream piecewise;
+    generateCode(piecewise, interp.naturalSpline(), options);
+    const std::string piecewiseText = piecewise.str();
+    if (!Contains(__func__, piecewiseText, "inline constexpr float spline_breakpoints[4] =")) return false;
+    if (!Contains(__func__, piecewiseText, "inline constexpr float spline_coefficients[12] =")) return false;
+    if (!Contains(__func__, piecewiseText, "5.00000000e-01f,")) return false;
+    if (!Contains(__func__, piecewiseText, "const float t = x - breaks[s];")) return false;
+
+    std::ostringstream bad;
+    if (!ExpectThrow<std::invalid_argument>(__func__, "NaN coefficient", [&]() { generateCode(bad, double_poly_t{1.0, std::nan("")}); })) return false;
+
+    return Pass(__func__);
 }
 
 
-static bool PolynomialDerivative()
+// A stream buffer that cannot seek, like a pipe or a socket.
+class OneWayBuffer : public std::streambuf
 {
-    using complex_t = std::complex<double>;
-    using poly_t = CosineKitty::Polynomial<complex_t, complex_t>;
-    poly_t poly {{2.0, 1.0}, {-3.0, 7.0}, {4.0, -2.0}, {-5.0, 8.0}};
-    const std::vector<complex_t> correct {{-3.0, 7.0}, {8.0, -4.0}, {-15.0, 24.0}};
-    poly_t deriv = poly.derivative();
-    return (
-        CompareCoeffs(__func__, deriv.coefficients(), correct) &&
-        Pass(__func__)
-    );
-}
+public:
+    explicit OneWayBuffer(std::string& text)
+    {
+        setg(&text[0], &text[0], &text[0] + text.size());
+    }
+};
 
 
-static bool PolynomialIntegral()
+static bool BinaryFormat()
 {
+    using namespace CosineKitty;
     using complex_t = std::complex<double>;
-    using poly_t = CosineKitty::Polynomial<complex_t, complex_t>;
-    poly_t poly {{2.0, 1.0}, {-3.0, 7.0}, {6.0, -3.0}, {-5.0, 8.0}};
-    const complex_t arbitraryConstant{6.0, 5.0};
+
+    // Polynomials survive a round trip exactly.
+    double_poly_t poly {1.0/3.0, -2.5, 0.0, 1.0e-300, 7.0};
+    std::stringstream stream;
+    writeBinary(stream, poly);
+    if (stream.str().size() != 32 + 5*sizeof(double))
+    {
+        printf("%s: FAIL: unexpected size %u\n", __func__, static_cast<unsigned>(stream.str().size()));
+        return false;
+    }
+    double_poly_t copy = readPolynomial<double, double>(stream);
+    if (!CompareCoeffs(__func__, copy.coefficients(), poly.coefficients(), 0.0)) return false;
+
+    Polynomial<double, complex_t> cpoly {complex_t{1.0, -1.0}, complex_t{0.5, 2.0}};
+    std::stringstream cstream;
+    writeBinary(cstream, cpoly);
+    if (readPolynomial<double, complex_t>(cstream).coefficients() != cpoly.coefficients())
+    {
+        printf("%s: FAIL: complex round trip.\n", __func__);
+        return false;
+    }
+
+    // Interpolator points keep their values and order.
+    Interpolator<float, float> interp;
+    interp.insert(2.0f, -1.0f);
+    interp.insert(0.5f, 3.25f);
+    interp.insert(-1.0f, 0.125f);
+    std::stringstream pstream;
+    writeBinary(pstream, interp);
+    Interpolator<float, float> loaded = readInterpolator<float, float>(pstream);
+    if (loaded.size() != interp.size())
+    {
+        printf("%s: FAIL: wrong number of points.\n", __func__);
+        return false;
+    }
+    for (std::size_t i = 0; i < interp.size(); ++i)
+    {
+        if (loaded.point(i) != interp.point(i))
+        {
+            printf("%s: FAIL: point %u does not match.\n", __func__, static_cast<unsigned>(i));
+            return false;
+        }
+    }
+
+    // A view evaluates the coefficients in place.
+    const std::string bytes = stream.str();
+    std::vector<double> storage((bytes.size() + sizeof(double) - 1) / sizeof(double));
+    std::memcpy(storage.data(), bytes.data(), bytes.size());
+    PolynomialView<double, double> view = viewPolynomial<double, double>(storage.data(), bytes.size());
+    if (view.size() != 5 || view.data() != storage.data() + 4)
+    {
+        printf("%s: FAIL: view does not refer to the buffer.\n", __func__);
+        return false;
+    }
+    for (double x = -2.0; x <= 2.0; x += 0.25)
+        if (!Check(__func__, x, poly(x), view(x), 0.0)) return false;
+
+    // Damaged or mismatched data is rejected.
+    std::string damaged = bytes;
+    damaged[40] ^= 1;
+    if (!ExpectThrow<std::runtime_error>(__func__, "damaged payload", [&]() { std::istringstream in(damaged); readPolynomial<double, double>(in); })) return false;
+    if (!ExpectThrow<std::runtime_error>(__func__, "truncated payload", [&]() { std::istringstream in(bytes.substr(0, 50)); readPolynomial<double, double>(in); })) return false;
+    if (!ExpectThrow<std::runtime_error>(__func__, "wrong numeric type", [&]() { std::istringstream in(bytes); readPolynomial<float, float>(in); })) return false;
+    if (!ExpectThrow<std::runtime_error>(__func__, "wrong kind", [&]() { std::istringstream in(bytes); readInterpolator<double, double>(in); })) return false;
+    if (!ExpectThrow<std::runtime_error>(__func__, "short view", [&]() { viewPolynomial<double, double>(storage.data(), bytes.size() - 1); })) return false;
+    std::vector<char> shifted(bytes.size() + 1);
+    std::memcpy(shifted.data() + 1, bytes.data(), bytes.size());
+    if (!ExpectThrow<std::runtime_error>(__func__, "misaligned view", [&]() { viewPolynomial<double, double>(shifted.data() + 1, bytes.size()); })) return false;
+
+    // A huge element count in a short record must not allocate the claimed size,
+    // whether or not the stream can seek.
+    std::string huge = bytes;
+    for (int i = 0; i < 8; ++i)
+        huge[16 + i] = static_cast<char>((i == 5) ? 0x10 : 0);   // 2^44 coefficients
+    if (!ExpectThrow<std::runtime_error>(__func__, "huge count", [&]() { std::istringstream in(huge); readPolynomial<double, double>(in); })) return false;
+    OneWayBuffer oneWay(huge);
+    std::istream pipe(&oneWay);
+    if (!ExpectThrow<std::runtime_error>(__func__, "huge count without seeking", [&]() { readPolynomial<double, double>(pipe); })) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PolynomialBankFile()
+{
+    using namespace CosineKitty;
+    const std::string filename = (std::filesystem::temp_directory_path() / "cosinekitty_bank_test.bin").string();
+
+    std::vector<double_poly_t> polys;
+    unsigned state = 1234;
+    for (int i = 0; i < 50; ++i)
+    {
+        std::vector<double> coeffs;
+        for (int k = 0; k <= i % 9; ++k)
+            coeffs.push_back(PseudoRandom(state));
+        polys.push_back(double_poly_t{coeffs});
+    }
+    polys.push_back(double_poly_t{});
+
+    {
+        std::ofstream out(filename, std::ios::binary);
+        writePolynomialBank(out, polys);
+    }
+
+    bool ok = true;
+    {
+        PolynomialBank<double, double> bank(filename);
+        if (bank.size() != polys.size())
+        {
+            printf("%s: FAIL: bank holds %u polynomials.\n", __func__, static_cast<unsigned>(bank.size()));
+            ok = false;
+        }
+        for (std::size_t i = 0; ok && i < polys.size(); ++i)
+        {
+            PolynomialView<double, double> view = bank[i];
+            if (reinterpret_cast<std::uintptr_t>(view.data()) % 64 != 0 || view.size() != polys[i].coefficients().size())
+            {
+                printf("%s: FAIL: polynomial %u has the wrong layout.\n", __func__, static_cast<unsigned>(i));
+                ok = false;
+            }
+            for (double x = -1.0; ok && x <= 1.0; x += 0.5)
+                ok = (view(x) == polys[i](x));
+        }
+
+        ok = ok && ExpectThrow<std::out_of_range>(__func__, "index past the end", [&]() { bank[polys.size()]; });
+        ok = ok && ExpectThrow<std::runtime_error>(__func__, "mismatched types", [&]() { PolynomialBank<float, float> wrongType(filename); });
+    }
+    std::filesystem::remove(filename);
+
+    if (!ok)
+        return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PointLoader()
+{
+    using namespace CosineKitty;
+    using interp_t = Interpolator<double, double>;
+
+    const std::string text =
+        "x,y\n"
+        "# comment line\n"
+        "0.5, 1.25\n"
+        "\n"
+        "  -2;+3e-1\r\n"
+        "4\t-0.125\n"
+        "0.5,99\n"
+        "1e2,7";
+
+    const std::pair<double, double> expected[] = {{0.5, 1.25}, {-2.0, 0.3}, {4.0, -0.125}, {100.0, 7.0}};
+    auto matches = [&](const interp_t& interp) -> bool
+    {
+        if (interp.size() != 4)
+            return false;
+        for (std::size_t i = 0; i < 4; ++i)
+            if (interp.point(i) != expected[i])
+                return false;
+        return true;
+    };
+
+    interp_t fromStream;
+    std::istringstream in(text);
+    if (loadCsvPoints(in, fromStream, 2) != 4 || !matches(fromStream))
+    {
+        printf("%s: FAIL: CSV stream points do not match.\n", __func__);
+        return false;
+    }
+
+    interp_t fromMemory;
+    if (loadCsvPoints(text.data(), text.size(), fromMemory) != 4 || !matches(fromMemory))
+    {
+        printf("%s: FAIL: CSV memory points do not match.\n", __func__);
+        return false;
+    }
+
+    // A bad line throws, but the points before it remain inserted.
+    interp_t bad;
+    const std::string badText = "1,2\n3,4\n5,x\n";
+    if (!ExpectThrow<std::runtime_error>(__func__, "invalid line", [&]() { loadCsvPoints(badText.data(), badText.size(), bad); }, "line 3")) return false;
+    const std::string nanText = "6,1\nnan,2\n";
+    if (!ExpectThrow<std::invalid_argument>(__func__, "NaN x value", [&]() { loadCsvPoints(nanText.data(), nanText.size(), bad); }, "line 2")) return false;
+    if (bad.size() != 3)
+    {
+        printf("%s: FAIL: expected 3 points before the bad lines, found %u.\n", __func__, static_cast<unsigned>(bad.size()));
+        return false;
+    }
+
+    // Text larger than one read block, so lines straddle block boundaries.
+    std::string big;
+    const std::size_t bigCount = 80000;
+    for (std::size_t i = 0; i < bigCount; ++i)
+        big += std::to_string(i) + ".5," + std::to_string(bigCount - i) + "\n";
+    interp_t bigInterp;
+    std::istringstream bigStream(big);
+    if (loadCsvPoints(bigStream, bigInterp) != bigCount || bigInterp.point(bigCount - 1) != std::make_pair(bigCount - 0.5, 1.0))
+    {
+        printf("%s: FAIL: large CSV stream.\n", __func__);
+        return false;
+    }
+
+    // Binary points load in chunks from a stream or from memory, skipping duplicates.
+    std::stringstream binary;
+    writeBinary(binary, fromStream);
+    const std::string bytes = binary.str();
+    interp_t merged;
+    merged.insert(4.0, 0.0);
+    if (loadBinaryPoints(binary, merged, 3) != 3 || merged.size() != 4)
+    {
+        printf("%s: FAIL: binary stream points.\n", __func__);
+        return false;
+    }
+    interp_t fromBytes;
+    if (loadBinaryPoints(bytes.data(), bytes.size(), fromBytes, 3) != 4 || !matches(fromBytes))
+    {
+        printf("%s: FAIL: binary memory points.\n", __func__);
+        return false;
+    }
+
+    // From memory or a seekable stream, a damaged payload leaves the interpolator exactly as it was.
+    std::string damaged = bytes;
+    damaged[damaged.size() - 1] ^= 1;
+    interp_t untouched;
+    untouched.insert(-7.0, 1.0);
+    std::istringstream damagedStream(damaged);
+    if (!ExpectThrow<std::runtime_error>(__func__, "damaged stream", [&]() { loadBinaryPoints(damagedStream, untouched, 1); })) return false;
+    if (!ExpectThrow<std::runtime_error>(__func__, "damaged memory", [&]() { loadBinaryPoints(damaged.data(), damaged.size(), untouched, 1); })) return false;
+    if (untouched.size() != 1)
+    {
+        printf("%s: FAIL: damaged data inserted %u points.\n", __func__, static_cast<unsigned>(untouched.size() - 1));
+        return false;
+    }
+
+    // A stream that cannot seek is read once, so the points arrive before the checksum fails.
+    OneWayBuffer oneWay(damaged);
+    std::istream pipe(&oneWay);
+    if (!ExpectThrow<std::runtime_error>(__func__, "damaged pipe", [&]() { loadBinaryPoints(pipe, untouched, 3); }, "checksum")) return false;
+    if (untouched.size() != 5)
+    {
+        printf("%s: FAIL: damaged pipe left %u points.\n", __func__, static_cast<unsigned>(untouched.size()));
+        return false;
+    }
+
+    // Bulk insertion follows the same rules as inserting one point at a time.
+    const double xs[] = {3.0, 1.0, 3.0, 2.0, 1.0};
+    const double ys[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    interp_t bulk;
+    bulk.insert(2.0, 0.0);
+    if (bulk.insert(xs, ys, 5) != 2 || bulk.point(1) != std::make_pair(3.0, 1.0) || bulk.point(2) != std::make_pair(1.0, 2.0) || bulk.insert(1.0, 9.0))
+    {
+        printf("%s: FAIL: bulk insertion.\n", __func__);
+        return false;
+    }
+
+    // NaN has no place in the sorted order of x values, so it is rejected.
+    const double nan = std::nan("");
+    const double withNaN[] = {10.0, nan, 11.0};
+    if (!ExpectThrow<std::invalid_argument>(__func__, "NaN x", [&]() { bulk.insert(nan, 1.0); })) return false;
+    if (!ExpectThrow<std::invalid_argument>(__func__, "NaN x in an array", [&]() { bulk.insert(withNaN, ys, 3); })) return false;
+    if (bulk.size() != 3)
+    {
+        printf("%s: FAIL: rejected array changed the interpolator.\n", __func__);
+        return false;
+    }
+
+    return Pass(__func__);
+}
+
+
+static bool MultiChannel()
+{
+    using namespace CosineKitty;
+    const std::size_t channels = 3;
+    using multi_t = MultiChannelInterpolator<double, double, channels>;
+    using value_t = multi_t::value_t;
+
+    multi_t multi;
+    CosineKitty::Interpolator<double, double> single[channels];
+    unsigned state = 77;
+    for (int i = 0; i < 7; ++i)
+    {
+        const double x = 0.4*i - 1.0;
+        value_t y;
+        for (std::size_t ch = 0; ch < channels; ++ch)
+        {
+            y[ch] = PseudoRandom(state);
+            single[ch].insert(x, y[ch]);
+        }
+        if (!multi.insert(x, y)) return false;
+    }
+    if (multi.insert(-1.0, value_t{}))
+    {
+        printf("%s: FAIL: duplicate x was accepted.\n", __func__);
+        return false;
+    }
+
+    MultiChannelPolynomial<double, double, channels> poly = multi.polynomial();
+    MultiChannelPolynomial<double, double, channels> slope = poly.derivative();
+    for (std::size_t ch = 0; ch < channels; ++ch)
+    {
+        const double_poly_t expected = single[ch].polynomial();
+        if (!CompareCoeffs(__func__, poly.channel(ch).coefficients(), expected.coefficients(), 1.0e-12)) return false;
+        if (!CompareCoeffs(__func__, slope.channel(ch).coefficients(), expected.derivative().coefficients(), 1.0e-12)) return false;
+    }
+
+    double xs[5];
+    value_t ys[5];
+    for (int i = 0; i < 5; ++i)
+        xs[i] = 0.3*i - 0.7;
+    poly.evaluate(xs, ys, 5);
+    for (int i = 0; i < 5; ++i)
+        for (std::size_t ch = 0; ch < channels; ++ch)
+            if (!Check(__func__, xs[i], poly.channel(ch)(xs[i]), ys[i][ch], 1.0e-14)) return false;
+
+    // Building from separate channels, and trailing zero powers, give the same layout.
+    std::array<double_poly_t, 2> parts = {double_poly_t{1.0, 2.0}, double_poly_t{3.0, 0.0, 5.0}};
+    MultiChannelPolynomial<double, double, 2> joined(parts);
+    MultiChannelPolynomial<double, double, 2> listed({{1.0, 3.0}, {2.0, 0.0}, {0.0, 5.0}, {0.0, 0.0}});
+    if (joined.powerCount() != 3 || joined.coefficients() != listed.coefficients() || listed.coefficient(2)[1] != 5.0)
+    {
+        printf("%s: FAIL: coefficient layout.\n", __func__);
+        return false;
+    }
+
+    if (MultiChannelInterpolator<double, double, 2>{}.polynomial().powerCount() != 0) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool SplitComplex()
+{
+    using namespace CosineKitty;
+    using complex_t = std::complex<double>;
+
+    unsigned state = 31;
+    std::vector<complex_t> coeffs;
+    for (int k = 0; k < 9; ++k)
+        coeffs.push_back(complex_t{PseudoRandom(state), PseudoRandom(state)});
+    const Polynomial<double, complex_t> realPoly {coeffs};
+    const Polynomial<complex_t, complex_t> complexPoly {coeffs};
+    const SplitComplexPolynomial<double> split {realPoly};
+
+    if (split.size() != coeffs.size() || split.toPolynomial().coefficients() != coeffs)
+    {
+        printf("%s: FAIL: split coefficients do not round trip.\n", __func__);
+        return false;
+    }
+
+    const std::size_t count = 300;
+    std::vector<double> x(count), zRe(count), zIm(count), yRe(count), yIm(count), fRe(count), fIm(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        x[i] = PseudoRandom(state);
+        zRe[i] = PseudoRandom(state);
+        zIm[i] = PseudoRandom(state);
+    }
+
+    split.evaluate(x.data(), yRe.data(), yIm.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const complex_t expected = realPoly(x[i]);
+        if (!Check(__func__, x[i], expected, split(x[i]), 1.0e-15)) return false;
+        if (!Check(__func__, x[i], expected, complex_t{yRe[i], yIm[i]}, 1.0e-15)) return false;
+    }
+
+    split.evaluate(zRe.data(), zIm.data(), yRe.data(), yIm.data(), count);
+    split.evaluate(zRe.data(), zIm.data(), fRe.data(), fIm.data(), count, ComplexMultiply::Fast);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const complex_t z {zRe[i], zIm[i]};
+        const complex_t expected = complexPoly(z);
+        if (complex_t{yRe[i], yIm[i]} != expected)
+        {
+            printf("%s: FAIL: strict evaluation differs from std::complex at z = (%lf, %lf)\n", __func__, z.real(), z.imag());
+            return false;
+        }
+        if (!Check(__func__, z.real(), expected, complex_t{fRe[i], fIm[i]}, 1.0e-14)) return false;
+        if (!Check(__func__, z.real(), expected, split(z, ComplexMultiply::Fast), 1.0e-14)) return false;
+    }
+
+    if (SplitComplexPolynomial<double>{}(complex_t{1.0, 1.0}) != complex_t{0.0}) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool GridSurface()
+{
+    using namespace CosineKitty;
+
+    // A polynomial surface of low enough degree is reproduced exactly.
+    auto surface = [](double x, double y) { return 1.0 + 2.0*x - y*y + 0.5*x*x*y*y*y; };
+    const std::vector<double> xs = {-1.0, -0.2, 0.5, 1.3};
+    const std::vector<double> ys = {-0.8, -0.1, 0.4, 0.9, 1.5};
+    std::vector<double> values;
+    for (double x : xs)
+        for (double y : ys)
+            values.push_back(surface(x, y));
+    GridInterpolator<double, double, 2> grid({xs, ys}, values);
+
+    for (double x : xs)
+        for (double y : ys)
+            if (!Check(__func__, x, surface(x, y), grid(x, y), 1.0e-13)) return false;
+
+    std::vector<GridInterpolator<double, double, 2>::point_t> points;
+    for (double x = -1.0; x <= 1.3; x += 0.23)
+        for (double y = -0.8; y <= 1.5; y += 0.19)
+            points.push_back({x, y});
+    std::vector<double> results(points.size());
+    grid.evaluate(points.data(), results.data(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+        if (!Check(__func__, points[i][0], surface(points[i][0], points[i][1]), results[i], 1.0e-13)) return false;
+
+    // In three dimensions, agree with nested one-dimensional interpolation.
+    auto field = [](double x, double y, double z) { return std::sin(x) * std::cos(y) + z*std::exp(0.3*x); };
+    const std::vector<double> axis = {0.0, 0.4, 0.8, 1.2};
+    std::vector<double> samples;
+    for (double x : axis)
+        for (double y : axis)
+            for (double z : axis)
+                samples.push_back(field(x, y, z));
+    GridInterpolator<double, double, 3> cube({axis, axis, axis}, samples);
+
+    const double qx = 0.3, qy = 0.95, qz = 0.6;
+    CosineKitty::Interpolator<double, double> across;
+    for (double x : axis)
+    {
+        CosineKitty::Interpolator<double, double> row;
+        for (double y : axis)
+        {
+            CosineKitty::Interpolator<double, double> column;
+            for (double z : axis)
+                column.insert(z, field(x, y, z));
+            row.insert(y, column.polynomial()(qz));
+        }
+        across.insert(x, row.polynomial()(qy));
+    }
+    if (!Check(__func__, qx, across.polynomial()(qx), cube(qx, qy, qz), 1.0e-12)) return false;
+
+    if (!ExpectThrow<std::invalid_argument>(__func__, "wrong number of values", [&]() { GridInterpolator<double, double, 2> bad({xs, ys}, std::vector<double>(3)); })) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool HermiteSlopes()
+{
+    using namespace CosineKitty;
+
+    // Values and slopes of exp(x) at 3 points determine a degree 5 polynomial.
+    HermiteInterpolator<double, double> hermite;
+    for (double x : {0.0, 0.5, 1.0})
+        if (!hermite.insert(x, std::exp(x), std::exp(x))) return false;
+    if (hermite.insert(0.5, 1.0))
+    {
+        printf("%s: FAIL: duplicate x was accepted.\n", __func__);
+        return false;
+    }
+    if (hermite.size() != 3 || hermite.conditionCount() != 6) return false;
+
+    double_poly_t poly = hermite.polynomial();
+    double_poly_t slope = poly.derivative();
+    if (poly.coefficients().size() != 6) return false;
+    for (double x : {0.0, 0.5, 1.0})
+    {
+        if (!Check(__func__, x, std::exp(x), poly(x), 1.0e-14)) return false;
+        if (!Check(__func__, x, std::exp(x), slope(x), 1.0e-13)) return false;
+    }
+
+    // Slopes make it much more accurate than interpolating values at the same points.
+    CosineKitty::Interpolator<double, double> plain;
+    for (double x : {0.0, 0.5, 1.0})
+        plain.insert(x, std::exp(x));
+    double_poly_t quadratic = plain.polynomial();
+    double hermiteError = 0.0;
+    double plainError = 0.0;
+    for (double x = 0.0; x <= 1.0; x += 0.01)
+    {
+        hermiteError = std::max(hermiteError, std::abs(poly(x) - std::exp(x)));
+        plainError = std::max(plainError, std::abs(quadratic(x) - std::exp(x)));
+    }
+    printf("%s: max error %g with slopes, %g without.\n", __func__, hermiteError, plainError);
+    if (hermiteError > 1.0e-5 || hermiteError * 100.0 > plainError) return false;
+
+    // Mixed numbers of derivatives: a cubic determined by f, f', f'' at one point and f at another.
+    double_poly_t cubic {2.0, -1.0, 0.5, 3.0};
+    double_poly_t d1 = cubic.derivative();
+    double_poly_t d2 = d1.derivative();
+    HermiteInterpolator<double, double> mixed;
+    mixed.insert(1.5, {cubic(1.5), d1(1.5), d2(1.5)});
+    mixed.insert(-1.0, cubic(-1.0));
+    if (!CompareCoeffs(__func__, mixed.polynomial().coefficients(), cubic.coefficients(), 1.0e-13)) return false;
+
+    // Without derivatives, it agrees with Interpolator.
+    HermiteInterpolator<double, double> valuesOnly;
+    for (double x : {0.0, 0.5, 1.0})
+        valuesOnly.insert(x, std::exp(x));
+    if (!CompareCoeffs(__func__, valuesOnly.polynomial().coefficients(), quadratic.coefficients(), 1.0e-14)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool RationalRunge()
+{
+    using namespace CosineKitty;
+
+    // Runge's function defeats polynomial interpolation at equally spaced points.
+    auto runge = [](double x) { return 1.0 / (1.0 + 25.0*x*x); };
+    const int n = 401;
+    std::vector<double> xs(n), ys(n);
+    for (int i = 0; i < n; ++i)
+    {
+        xs[i] = -1.0 + 2.0*i/(n-1);
+        ys[i] = runge(xs[i]);
+    }
+
+    RationalInterpolator<double, double> bulk(4);
+    if (bulk.insert(xs.data(), ys.data(), n) != static_cast<std::size_t>(n)) return false;
+
+    // Inserting one at a time, in scrambled order, gives the same weights.
+    RationalInterpolator<double, double> single(4);
+    for (int i = 0; i < n; ++i)
+    {
+        const int k = (i * 151) % n;
+        if (!single.insert(xs[k], ys[k])) return false;
+    }
+    if (single.insert(xs[7], 0.0) || single.size() != bulk.size())
+    {
+        printf("%s: FAIL: duplicate x was accepted.\n", __func__);
+        return false;
+    }
+
+    // NaN x values are rejected before anything is inserted.
+    const double nanX[] = {5.0, std::nan("")};
+    const double nanY[] = {1.0, 2.0};
+    if (!ExpectThrow<std::invalid_argument>(__func__, "single NaN x", [&]() { single.insert(std::nan(""), 1.0); })) return false;
+    if (!ExpectThrow<std::invalid_argument>(__func__, "bulk NaN x", [&]() { single.insert(nanX, nanY, 2); })) return false;
+    if (single.size() != bulk.size())
+    {
+        printf("%s: FAIL: NaN insertion changed the size.\n", __func__);
+        return false;
+    }
+
+    std::vector<double> qx, qy(1000);
+    for (int i = 0; i < 1000; ++i)
+        qx.push_back(-1.0 + 0.002*i + 0.0007);
+    bulk.evaluate(qx.data(), qy.data(), qx.size());
+    double maxdiff = 0.0;
+    for (std::size_t i = 0; i < qx.size(); ++i)
+    {
+        maxdiff = std::max(maxdiff, std::abs(qy[i] - runge(qx[i])));
+        if (std::abs(single(qx[i]) - qy[i]) > 1.0e-13)
+        {
+            printf("%s: FAIL: incremental and bulk weights disagree at x = %lf\n", __func__, qx[i]);
+            return false;
+        }
+    }
+    if (!Check(__func__, 0.0, 0.0, maxdiff, 1.0e-7)) return false;
+    if (bulk(xs[100]) != ys[100]) return false;
+
+    // Polynomials up to the blending degree are reproduced exactly.
+    double_poly_t cubic {0.5, -1.0, 2.0, 0.25};
+    RationalInterpolator<double, double> exact(3);
+    for (double x : {0.0, 0.3, 1.1, 1.2, 2.0, 3.7, 4.0})
+        exact.insert(x, cubic(x));
+    for (double x = -0.5; x <= 4.5; x += 0.37)
+        if (!Check(__func__, x, cubic(x), exact(x), 1.0e-12)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool LeastSquaresFit()
+{
+    using namespace CosineKitty;
+
+    // Noisy samples of a known cubic.
+    double_poly_t truth {1.0, -2.0, 0.5, 3.0};
+    const std::size_t count = 100000;
+    std::vector<double> xs(count), ys(count);
+    unsigned state = 2024;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        xs[i] = 2.0 + 3.0*(PseudoRandom(state) + 1.0)/2.0;
+        ys[i] = truth(xs[i]) + 0.01*PseudoRandom(state);
+    }
+
+    LeastSquaresFitter<double, double> fitter(3, 2.0, 5.0);
+    fitter.add(xs.data(), ys.data(), count);
+    double_poly_t fit = fitter.polynomial();
+    if (fitter.count() != count || fit.coefficients().size() != 4) return false;
+    for (double x = 2.0; x <= 5.0; x += 0.25)
+        if (!Check(__func__, x, truth(x), fit(x), 1.0e-3)) return false;
+
+    // The residual matches the fitted polynomial's actual errors.
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+        sum += (ys[i] - fit(xs[i])) * (ys[i] - fit(xs[i]));
+    if (!Check(__func__, 0.0, std::sqrt(sum), fitter.residual(), 1.0e-9 * std::sqrt(sum))) return false;
+
+    // Fitting halves separately and merging gives the same result.
+    LeastSquaresFitter<double, double> first(3, 2.0, 5.0);
+    LeastSquaresFitter<double, double> second(3, 2.0, 5.0);
+    first.add(xs.data(), ys.data(), count/2);
+    second.add(xs.data() + count/2, ys.data() + count/2, count - count/2);
+    first.merge(second);
+    if (first.count() != count) return false;
+    if (!CompareCoeffs(__func__, first.polynomial().coefficients(), fit.coefficients(), 1.0e-9)) return false;
+    if (!Check(__func__, 0.0, fitter.residual(), first.residual(), 1.0e-9)) return false;
+
+    // Exactly degree+1 points reproduce the interpolating polynomial with no residual.
+    LeastSquaresFitter<double, double> exact(2);
+    exact.add(-1.0, 3.0);
+    exact.add(0.0, 1.0);
+    exact.add(0.5, 2.0);
+    CosineKitty::Interpolator<double, double> interp;
+    interp.insert(-1.0, 3.0);
+    interp.insert(0.0, 1.0);
+    interp.insert(0.5, 2.0);
+    if (!CompareCoeffs(__func__, exact.polynomial().coefficients(), interp.polynomial().coefficients(), 1.0e-14)) return false;
+    if (!Check(__func__, 0.0, 0.0, exact.residual(), 1.0e-14)) return false;
+
+    // An integer weight counts the same as adding the point that many times.
+    const double wx[] = {-0.5, 0.0, 0.25, 0.75, 1.0};
+    const double wy[] = {1.0, -1.0, 0.5, 2.0, 0.0};
+    const double weights[] = {1.0, 3.0, 2.0, 1.0, 4.0};
+    LeastSquaresFitter<double, double> weighted(2);
+    LeastSquaresFitter<double, double> repeated(2);
+    weighted.add(wx, wy, weights, 5);
+    for (int i = 0; i < 5; ++i)
+        for (int k = 0; k < static_cast<int>(weights[i]); ++k)
+            repeated.add(wx[i], wy[i]);
+    if (!CompareCoeffs(__func__, weighted.polynomial().coefficients(), repeated.polynomial().coefficients(), 1.0e-14)) return false;
+
+    // Negative or NaN weights are rejected, and a rejected array adds nothing.
+    const double badWeights[] = {1.0, 1.0, -1.0, 1.0, 1.0};
+    if (!ExpectThrow<std::invalid_argument>(__func__, "negative weight", [&]() { weighted.add(0.5, 1.0, -1.0); })) return false;
+    if (!ExpectThrow<std::invalid_argument>(__func__, "NaN weight", [&]() { weighted.add(0.5, 1.0, std::nan("")); })) return false;
+    if (!ExpectThrow<std::invalid_argument>(__func__, "negative weight in an array", [&]() { weighted.add(wx, wy, badWeights, 5); })) return false;
+    if (weighted.count() != 5)
+    {
+        printf("%s: FAIL: rejected weights changed the count to %u.\n", __func__, static_cast<unsigned>(weighted.count()));
+        return false;
+    }
+
+    LeastSquaresFitter<double, double> tooFew(2);
+    tooFew.add(0.0, 1.0);
+    tooFew.add(0.0, 2.0);
+    tooFew.add(1.0, 0.0);
+    if (!ExpectThrow<std::range_error>(__func__, "too few distinct points", [&]() { tooFew.polynomial(); })) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool StreamingWindow()
+{
+    using namespace CosineKitty;
+
+    // A cubic is reproduced exactly by a 4-point window.
+    auto cubic = [](double t) { return 1.0 + 2.0*t - t*t + 0.5*t*t*t; };
+    StreamingInterpolator<double, double> stream(4);
+    for (int i = 0; i < 200; ++i)
+    {
+        const double t = 0.1 * i;
+        if (!stream.push(t, cubic(t)))
+        {
+            printf("%s: FAIL: push rejected at i=%d\n", __func__, i);
+            return false;
+        }
+        if (stream.size() != static_cast<std::size_t>(std::min(i+1, 4))) return false;
+        if (stream.full())
+        {
+            if (!Check(__func__, t, cubic(t), stream(t), 0.0)) return false;
+            if (!Check(__func__, t, cubic(t + 0.05), stream(t + 0.05), 1.0e-11)) return false;
+            if (!Check(__func__, t, cubic(t - 0.17), stream(t - 0.17), 1.0e-11)) return false;
+        }
+    }
+
+    // A duplicate x value within the window is rejected.
+    if (stream.push(19.8, 0.0)) return false;
+
+    // After many updates, the window still matches a fresh interpolation of the same points.
+    StreamingInterpolator<double, double> wave(6);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double t = 0.01 * i;
+        wave.push(t, std::sin(3.0*t));
+    }
+    StreamingInterpolator<double, double> fresh(6);
+    for (int i = 9994; i < 10000; ++i)
+    {
+        const double t = 0.01 * i;
+        fresh.push(t, std::sin(3.0*t));
+    }
+    for (double t = 99.94; t < 99.995; t += 0.005)
+    {
+        if (!Check(__func__, t, fresh(t), wave(t), 1.0e-12)) return false;
+        if (!Check(__func__, t, std::sin(3.0*t), wave(t), 1.0e-9)) return false;
+    }
+
+    // Single precision weights do not drift over a long stream.
+    StreamingInterpolator<float, float> drift(5);
+    StreamingInterpolator<float, float> reference(5);
+    for (int i = 0; i < 200000; ++i)
+    {
+        const float t = 0.25f * static_cast<float>(i % 4000);
+        drift.push(t, std::cos(t));
+        if (i >= 200000 - 5)
+            reference.push(t, std::cos(t));
+    }
+    for (float t = 999.0f; t < 999.75f; t += 0.125f)
+        if (!Check(__func__, t, reference(t), drift(t), 1.0e-4)) return false;
+
+    // Materializing the window's polynomial gives the same values.
+    double_poly_t windowPoly = stream.polynomial();
+    if (!Check(__func__, 19.75, cubic(19.75), windowPoly(19.75), 1.0e-5)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool ResampleAudio()
+{
+    using namespace CosineKitty;
+
+    const double pi = 3.14159265358979323846;
+    const double inRate = 44100.0;
+    const double outRate = 48000.0;
+    const double freq = 440.0;
+
+    LagrangeResampler<float> resampler(inRate, outRate, 3, 1024, 512);
+    if (resampler.taps() != 4) return false;
+
+    std::vector<float> input(20000);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<float>(std::sin(2.0*pi*freq*i/inRate));
+
+    std::vector<float> output;
+    float block[64];
+    std::size_t offset = 0;
+    while (offset < input.size())
+    {
+        offset += resampler.push(&input[offset], std::min<std::size_t>(100, input.size() - offset));
+        std::size_t n;
+        while ((n = resampler.pull(block, 64)) > 0)
+            output.insert(output.end(), block, block + n);
+    }
+
+    const std::size_t expected = static_cast<std::size_t>((input.size() - 2) * outRate / inRate);
+    if (output.size() + 2 < expected || output.size() > expected + 2)
+    {
+        printf("%s: FAIL: expected about %u output samples, found %u\n", __func__,
+            static_cast<unsigned>(expected), static_cast<unsigned>(output.size()));
+        return false;
+    }
+
+    double maxdiff = 0.0;
+    for (std::size_t j = 2; j < output.size(); ++j)
+    {
+        const double correct = std::sin(2.0*pi*freq*j/outRate);
+        maxdiff = std::max(maxdiff, std::abs(output[j] - correct));
+    }
+    if (!Check(__func__, 0.0, 0.0, maxdiff, 1.0e-4)) return false;
+
+    // Converting at the same rate reproduces the input exactly.
+    LagrangeResampler<float> identity(inRate, inRate, 5);
+    std::vector<float> copy(input.size());
+    std::size_t pushed = identity.push(input.data(), 1000);
+    std::size_t pulled = identity.pull(copy.data(), copy.size());
+    if (pushed != 1000 || pulled != 997) return false;
+    for (std::size_t i = 0; i < pulled; ++i)
+        if (copy[i] != input[i]) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool InterpUniform()
+{
+    using namespace CosineKitty;
+
+    const double x0 = -1.5;
+    const double h = 0.25;
+    const int n = 11;
+    std::vector<double> ys;
+    Interpolator<double, double> general;
+    for (int i = 0; i < n; ++i)
+    {
+        const double x = x0 + i*h;
+        const double y = std::exp(0.5*x) - x*x;
+        ys.push_back(y);
+        general.insert(x, y);
+    }
+
+    UniformInterpolator<double, double> uniform(x0, h, ys);
+    double_poly_t fast = uniform.polynomial();
+    double_poly_t slow = general.polynomial();
+    if (!CompareCoeffs(__func__, fast.coefficients(), slow.coefficients(), 1.0e-10)) return false;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const double x = x0 + i*h;
+        if (!Check(__func__, x, ys[i], uniform(x), 0.0)) return false;
+        if (!Check(__func__, x, ys[i], fast(x), 1.0e-12)) return false;
+    }
+
+    for (double x = -1.4; x < 1.0; x += 0.1)
+        if (!Check(__func__, x, slow(x), uniform(x), 1.0e-10)) return false;
+
+    // Complex values at real points.
+    using complex_t = std::complex<double>;
+    UniformInterpolator<double, complex_t> cinterp(2.0, -0.5, {{1.0, 2.0}, {3.0, -1.0}, {0.5, 0.5}});
+    Polynomial<double, complex_t> cpoly = cinterp.polynomial();
+    if (!Check(__func__, 1.0, complex_t{0.5, 0.5}, cpoly(1.0), 1.0e-14)) return false;
+    if (!Check(__func__, 1.5, complex_t{3.0, -1.0}, cpoly(1.5), 1.0e-14)) return false;
+
+    // Many points, where weights of 1/(n-1)! would underflow.
+    std::vector<double> wide;
+    for (int i = 0; i < 200; ++i)
+        wide.push_back(std::cos(0.01 * i));
+    UniformInterpolator<double, double> big(0.0, 0.01, wide);
+    for (double x = 0.9; x < 1.1; x += 0.0137)
+        if (!Check(__func__, x, std::cos(x), big(x), 1.0e-12)) return false;
+
+    std::vector<float> narrow;
+    for (int i = 0; i < 50; ++i)
+        narrow.push_back(std::cos(0.02f * i));
+    UniformInterpolator<float, float> fbig(0.0f, 0.02f, narrow);
+    for (float x = 0.45f; x < 0.55f; x += 0.0137f)
+        if (!Check(__func__, x, std::cos(x), fbig(x), 1.0e-5)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool FailDuplicate()
+{
+    CosineKitty::Interpolator<double, double> interp;
+
+    if (!interp.insert(3.0, 4.0))
+    {
+        printf("%s: should have inserted first point.\n", __func__);
+        return false;
+    }
+
+    if (interp.insert(3.0, 5.0))
+    {
+        printf("%s: should NOT have inserted second point.\n", __func__);
+        return false;
+    }
+
+    return Pass(__func__);
+}
+
+
+static double TestEval(std::function<double(double)> func, double x)
+{
+    return func(x);
+}
+
+
+static bool PassAsFunction()
+{
+    // Verify that a polynomial can be passed as a C++ std::function,
+    // just like a lambda can.
+    double_poly_t poly {17.0, 5.0, -3.0};      // -3x^2 + 5x + 17
+    double yCalc = TestEval(poly, 2.0);
+    double yCorrect = -3.0*(2.0*2.0) + 5.0*(2.0) + 17.0;
+    double diff = std::abs(yCalc - yCorrect);
+    printf("%s: diff = %le\n", __func__, diff);
+    return Pass(__func__);
+}
+
+
+static bool TruncateTrailingZeroCoeffs()
+{
+    // It is wasteful to retain high-order coefficients that are zero.
+    // For example, [3, 7, 0, 0] represents f(x) = 0*x^3 + 0*x^2 + 7*x + 3.
+    // This should automatically be converted to [3, 7] = 7*x + 3.
+    // Test this in a yucky case where range_t is complex.
+    using range_t = std::complex<float>;
+    using poly_t = CosineKitty::Polynomial<float, range_t>;
+
+    poly_t poly {3, 7, 0, 0};
+    std::vector<range_t> check {3, 7};
+
+    return (
+        CompareCoeffs(__func__, poly.coefficients(), check) &&
+        Pass(__func__)
+    );
+}
+
+
+static bool PolynomialDerivative()
+{
+    using complex_t = std::complex<double>;
+    using poly_t = CosineKitty::Polynomial<complex_t, complex_t>;
+    poly_t poly {{2.0, 1.0}, {-3.0, 7.0}, {4.0, -2.0}, {-5.0, 8.0}};
+    const std::vector<complex_t> correct {{-3.0, 7.0}, {8.0, -4.0}, {-15.0, 24.0}};
+    poly_t deriv = poly.derivative();
+    return (
+        CompareCoeffs(__func__, deriv.coefficients(), correct) &&
+        Pass(__func__)
+    );
+}
+
+
+static bool PolynomialIntegral()
+{
+    using complex_t = std::complex<double>;
+    using poly_t = CosineKitty::Polynomial<complex_t, complex_t>;
+    poly_t poly {{2.0, 1.0}, {-3.0, 7.0}, {6.0, -3.0}, {-5.0, 8.0}};
+    const complex_t arbitraryConstant{6.0, 5.0};
     const std::vector<complex_t> correct {arbitraryConstant, {2.0, 1.0}, {-1.5, 3.5}, {2.0, -1.0}, {-1.25, 2.0}};
     poly_t integral = poly.integral(arbitraryConstant);
     poly_t check = integral.derivative();   // verify we can take derivative and obtain original function
@@ -425,6 +1939,103 @@ static bool PolynomialIntegral()
 }
 
 
+static bool PolynomialEvalDerivatives()
+{
+    double_poly_t poly {2, -3, 5, 7, -1};   // -x^4 + 7x^3 + 5x^2 - 3x + 2
+    const std::size_t order = 6;
+    const double xs[] = { -1.5, 0.0, 0.25, 2.0 };
+    const std::size_t count = sizeof(xs) / sizeof(xs[0]);
+
+    double batch[count * (order+1)];
+    poly.evaluateWithDerivatives(xs, batch, count, order);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double results[order+1];
+        poly.evaluateWithDerivatives(xs[i], results, order);
+        std::array<double, order+1> fixed = poly.evaluateWithDerivatives<order>(xs[i]);
+
+        double_poly_t deriv = poly;
+        for (std::size_t j = 0; j <= order; ++j)
+        {
+            const double correct = deriv(xs[i]);
+            if (!Check(__func__, xs[i], correct, results[j], 1.0e-12)) return false;
+            if (!Check(__func__, xs[i], correct, fixed[j], 1.0e-12)) return false;
+            if (!Check(__func__, xs[i], correct, batch[i*(order+1) + j], 1.0e-12)) return false;
+            deriv = deriv.derivative();
+        }
+    }
+
+    // The zero polynomial has all zero derivatives.
+    double zero[3] = { 1.0, 1.0, 1.0 };
+    double_poly_t{}.evaluateWithDerivatives(3.0, zero, 2);
+    if (zero[0] != 0.0 || zero[1] != 0.0 || zero[2] != 0.0) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PolynomialViews()
+{
+    using complex_t = std::complex<double>;
+    using poly_t = CosineKitty::Polynomial<complex_t, complex_t>;
+    poly_t poly {{2.0, 1.0}, {-3.0, 7.0}, {6.0, -3.0}, {-5.0, 8.0}, {1.5, 0.5}};
+    const complex_t xs[] = { {0.0, 0.0}, {1.5, -0.5}, {-2.0, 0.75} };
+
+    poly_t deriv = poly;
+    for (std::size_t order = 0; order <= 6; ++order)
+    {
+        auto view = poly.derivativeView(order);
+        if (!CompareCoeffs(__func__, view.polynomial().coefficients(), deriv.coefficients(), 1.0e-14)) return false;
+        for (complex_t x : xs)
+            if (!Check(__func__, x.real(), deriv(x), view(x), 1.0e-12)) return false;
+        deriv = deriv.derivative();
+    }
+
+    const complex_t arbitraryConstant{6.0, 5.0};
+    poly_t integral = poly.integral(arbitraryConstant);
+    auto iview = poly.integralView(arbitraryConstant);
+    if (!CompareCoeffs(__func__, iview.polynomial().coefficients(), integral.coefficients())) return false;
+    for (complex_t x : xs)
+        if (!Check(__func__, x.real(), integral(x), iview(x), 1.0e-12)) return false;
+
+    // Views of the zero polynomial.
+    poly_t zero;
+    if (!Check(__func__, 1.0, complex_t{0.0}, zero.derivativeView()(complex_t{1.0}), 0.0)) return false;
+    if (!Check(__func__, 1.0, arbitraryConstant, zero.integralView(arbitraryConstant)(complex_t{1.0}), 0.0)) return false;
+
+    return Pass(__func__);
+}
+
+
+static bool PolynomialDefiniteIntegral()
+{
+    double_poly_t poly {2, -3, 5, 7, -1};
+    double_poly_t anti = poly.integral();
+
+    const std::size_t count = 1000;
+    std::vector<double> a(count), b(count), results(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        a[i] = -3.0 + 0.004*i;
+        b[i] = 2.5 - 0.003*i;
+    }
+    poly.definiteIntegral(a.data(), b.data(), results.data(), count);
+
+    for (std::size_t i = 0; i < count; i += 37)
+    {
+        const double correct = anti(b[i]) - anti(a[i]);
+        if (!Check(__func__, a[i], correct, poly.definiteIntegral(a[i], b[i]), 1.0e-12)) return false;
+        if (!Check(__func__, a[i], correct, results[i], 1.0e-12)) return false;
+    }
+
+    // The integral of the zero polynomial is zero.
+    if (!Check(__func__, 1.0, 0.0, double_poly_t{}.definiteIntegral(1.0, 2.0), 0.0)) return false;
+
+    return Pass(__func__);
+}
+
+
 static bool PolynomialCompose()
 {
     double_poly_t f{7.5, -1, 1};        // x^2 - x + 7.5
@@ -460,9 +2071,34 @@ int main()
         PolynomialUnary() &&
         PolynomialDerivative() &&
         PolynomialIntegral() &&
+        PolynomialEvalDerivatives() &&
+        PolynomialViews() &&
+        PolynomialDefiniteIntegral() &&
         PolynomialCompose() &&
+        PolynomialDivide() &&
+        ChebyshevBasics() &&
+        PolynomialReduceDegree() &&
+        PolynomialMinimax() &&
+        PolynomialRoots() &&
+        PolynomialBatchEvaluate() &&
         InterpTestDouble() &&
         InterpTestComplex() &&
+        InterpParallel() &&
+        InterpUniform() &&
+        InterpPiecewise() &&
+        InterpSplines() &&
+        CodeGeneration() &&
+        BinaryFormat() &&
+        PolynomialBankFile() &&
+        PointLoader() &&
+        MultiChannel() &&
+        SplitComplex() &&
+        GridSurface() &&
+        HermiteSlopes() &&
+        RationalRunge() &&
+        LeastSquaresFit() &&
+        StreamingWindow() &&
+        ResampleAudio() &&
         FailDuplicate() &&
         PassAsFunction() &&
         TruncateTrailingZeroCoeffs()